@@ -4,6 +4,110 @@
 
 namespace ai {
 
+// Several of the monthly ai routines are split in two: a parallel pass that only reads the state and notes down what
+// each nation means to do, and a serial pass that then does it, nation by nation in id order. The outcome is the same
+// whatever the number of threads, and all nations decide on the state as it was before any of them acted.
+template<typename T>
+struct nation_actions {
+	std::vector<std::vector<T>> per_nation;
+
+	void reset(sys::state& state) {
+		per_nation.resize(state.world.nation_size());
+		for(auto& v : per_nation)
+			v.clear();
+	}
+	std::vector<T>& operator[](dcon::nation_id n) {
+		return per_nation[n.index()];
+	}
+	template<typename F>
+	void apply(F&& f) {
+		for(uint32_t i = 0; i < uint32_t(per_nation.size()); ++i) {
+			for(auto& a : per_nation[i])
+				f(dcon::nation_id{ dcon::nation_id::value_base_t(i) }, a);
+		}
+	}
+};
+
+static uint32_t monthly_job_day(uint32_t nation_index, uint32_t job, uint32_t days) {
+	uint64_t h = ((uint64_t(nation_index) << 8) | job) * 0x9E3779B97F4A7C15ull;
+	h ^= h >> 29;
+	return uint32_t(h % days);
+}
+
+void update_monthly_schedule(sys::state& state) {
+	auto& sc = state.ai_schedule;
+	auto ymd_date = state.current_date.to_ymd(state.start_date);
+	auto month_start = sys::year_month_day{ ymd_date.year, ymd_date.month, uint16_t(1) };
+	auto next_month_start = ymd_date.month != 12 ? sys::year_month_day{ ymd_date.year, uint16_t(ymd_date.month + 1), uint16_t(1) } : sys::year_month_day{ ymd_date.year + 1, uint16_t(1), uint16_t(1) };
+	auto const days_in_month = uint32_t(sys::days_difference(month_start, next_month_start));
+	auto const today = uint32_t(ymd_date.day - 1);
+
+	auto const job_count = uint32_t(monthly_job::count);
+	sc.words_per_job = (state.world.nation_size() + 63) / 64;
+	sc.due.assign(sc.words_per_job * job_count, 0);
+	sc.due_today = 0;
+	sc.in_use = true;
+
+	// only nations that will actually do something count against the budget
+	auto const month = int32_t(ymd_date.year) * 12 + int32_t(ymd_date.month);
+	auto& pairs = sc.pairs;
+	auto& day_start = sc.day_start;
+	if(sc.month != month || day_start.size() != days_in_month + 1) {
+		sc.month = month;
+		day_start.assign(days_in_month + 1, 0);
+		for(auto n : state.world.in_nation) {
+			if(n.get_is_player_controlled() || n.get_owned_province_count() == 0)
+				continue;
+			for(uint32_t j = 0; j < job_count; ++j)
+				++day_start[monthly_job_day(n.id.index(), j, days_in_month) + 1];
+		}
+		for(uint32_t d = 0; d < days_in_month; ++d)
+			day_start[d + 1] += day_start[d];
+		pairs.resize(day_start[days_in_month]);
+		sc.fill.assign(day_start.begin(), day_start.end() - 1);
+		for(uint32_t j = 0; j < job_count; ++j) {
+			for(auto n : state.world.in_nation) {
+				if(n.get_is_player_controlled() || n.get_owned_province_count() == 0)
+					continue;
+				pairs[sc.fill[monthly_job_day(n.id.index(), j, days_in_month)]++] = (j << 16) | uint32_t(n.id.index());
+			}
+		}
+	}
+
+	uint32_t budget = uint32_t(std::max(0.0f, state.defines.alice_ai_daily_job_budget));
+	if(budget == 0)
+		budget = (uint32_t(pairs.size()) + days_in_month - 1) / days_in_month;
+	budget = std::max(budget, uint32_t(1));
+
+	// the pairs of a day are taken after those carried over from earlier days; as they are grouped by day, that is
+	// simply the next ones in order
+	uint32_t taken = 0;
+	for(uint32_t d = 0; d <= today; ++d) {
+		auto available = day_start[std::min(d + 1, days_in_month)];
+		auto end = (d + 1 >= days_in_month) ? available : std::min(available, taken + budget);
+		if(d == today) {
+			for(uint32_t i = taken; i < end; ++i) {
+				auto j = pairs[i] >> 16;
+				auto n = pairs[i] & 0xFFFF;
+				sc.due[j * sc.words_per_job + n / 64] |= uint64_t(1) << (n % 64);
+			}
+			sc.due_today = end - taken;
+		}
+		taken = end;
+	}
+}
+
+void end_monthly_schedule(sys::state& state) {
+	state.ai_schedule.in_use = false;
+}
+
+bool is_due(sys::state const& state, monthly_job j, dcon::nation_id n) {
+	auto const& sc = state.ai_schedule;
+	if(!sc.in_use)
+		return true;
+	return (sc.due[uint32_t(j) * sc.words_per_job + n.index() / 64] >> (n.index() % 64)) & 1;
+}
+
 float estimate_strength(sys::state& state, dcon::nation_id n) {
 	float value = state.world.nation_get_military_score(n);
 	for(auto subj : state.world.nation_get_overlord_as_ruler(n))
@@ -330,7 +434,8 @@ void update_ai_research(sys::state& state) {
 	concurrency::parallel_for(uint32_t(0), state.world.nation_size(), [&](uint32_t id) {
 		dcon::nation_id n{ dcon::nation_id::value_base_t(id) };
 
-		if(state.world.nation_get_is_player_controlled(n)
+		if(!is_due(state, monthly_job::research, n)
+			|| state.world.nation_get_is_player_controlled(n)
 			|| state.world.nation_get_current_research(n)
 			|| !state.world.nation_get_is_civilized(n)
 			|| state.world.nation_get_owned_province_count(n) == 0) {
@@ -789,7 +894,7 @@ bool ai_can_appoint_political_party(sys::state& state, dcon::nation_id n) {
 void update_ai_ruling_party(sys::state& state) {
 	for(auto n : state.world.in_nation) {
 		// skip over: non ais, dead nations
-		if(n.get_is_player_controlled() || n.get_owned_province_count() == 0)
+		if(n.get_is_player_controlled() || n.get_owned_province_count() == 0 || !is_due(state, monthly_job::ruling_party, n))
 			continue;
 
 		if(ai_can_appoint_political_party(state, n)) {
@@ -862,27 +967,41 @@ void get_desired_factory_types(sys::state& state, dcon::nation_id nid, std::vect
 	}
 }
 
+struct econ_construction_action {
+	dcon::state_instance_id si; // a factory in this state ...
+	dcon::province_id p; // ... or a building in this province
+	dcon::factory_type_id factory_type;
+	economy::province_building_type building_type = economy::province_building_type::railroad;
+	bool is_upgrade = false;
+};
+
 void update_ai_econ_construction(sys::state& state) {
-	for(auto n : state.world.in_nation) {
+	static nation_actions<econ_construction_action> actions;
+	actions.reset(state);
+
+	concurrency::parallel_for(uint32_t(0), state.world.nation_size(), [&](uint32_t index) {
+		auto n = fatten(state.world, dcon::nation_id{ dcon::nation_id::value_base_t(index) });
 		// skip over: non ais, dead nations, and nations that aren't making money
 		if(n.get_is_player_controlled() || n.get_owned_province_count() == 0 || !n.get_is_civilized())
-			continue;
+			return;
+		if(!is_due(state, monthly_job::econ_construction, n))
+			return;
 		if(n.get_spending_level() < 1.0f || n.get_last_treasury() >= n.get_stockpiles(economy::money))
-			continue;
+			return;
+
+		auto& planned = actions[n];
 
 		auto treasury = n.get_stockpiles(economy::money);
 		int32_t max_projects = std::max(8, int32_t(treasury / 8000.0f));
 		auto rules = n.get_combined_issue_rules();
 
 		if((rules & issue_rule::expand_factory) != 0 || (rules & issue_rule::build_factory) != 0) {
-			static::std::vector<dcon::factory_type_id> desired_types;
-			desired_types.clear();
+			std::vector<dcon::factory_type_id> desired_types;
 			get_desired_factory_types(state, n, desired_types);
 
 			// desired types filled: try to construct or upgrade
 			if(!desired_types.empty()) {
-				static std::vector<dcon::state_instance_id> ordered_states;
-				ordered_states.clear();
+				std::vector<dcon::state_instance_id> ordered_states;
 				for(auto si : n.get_state_ownership()) {
 					if(si.get_state().get_capital().get_is_colonial() == false)
 						ordered_states.push_back(si.get_state().id);
@@ -922,11 +1041,12 @@ void update_ai_econ_construction(sys::state& state) {
 											break;
 										}
 									}
+									for(auto& a : planned) {
+										if(a.si == si && a.factory_type == type)
+											ug_in_progress = true;
+									}
 									if(!ug_in_progress) {
-										auto new_up = fatten(state.world, state.world.force_create_state_building_construction(si, n));
-										new_up.set_is_pop_project(false);
-										new_up.set_is_upgrade(true);
-										new_up.set_type(type);
+										planned.push_back(econ_construction_action{ si, dcon::province_id{}, type, economy::province_building_type::railroad, true });
 
 										--max_projects;
 										return;
@@ -964,6 +1084,10 @@ void update_ai_econ_construction(sys::state& state) {
 								if(p.get_type() == type_selection)
 									return true;
 							}
+							for(auto& a : planned) { // not carried out yet, so not among the constructions above
+								if(a.si == si && a.factory_type == type_selection)
+									return true;
+							}
 							return false;
 							}();
 							if(already_in_progress)
@@ -988,10 +1112,7 @@ void update_ai_econ_construction(sys::state& state) {
 							}
 							if(present_in_location) {
 								if((rules & issue_rule::expand_factory) != 0) {
-									auto new_up = fatten(state.world, state.world.force_create_state_building_construction(si, n));
-									new_up.set_is_pop_project(false);
-									new_up.set_is_upgrade(true);
-									new_up.set_type(type_selection);
+									planned.push_back(econ_construction_action{ si, dcon::province_id{}, type_selection, economy::province_building_type::railroad, true });
 									--max_projects;
 								}
 								continue;
@@ -999,11 +1120,12 @@ void update_ai_econ_construction(sys::state& state) {
 
 							// else -- try to build -- must have room
 							int32_t num_factories = economy::state_factory_count(state, si, n);
+							for(auto& a : planned) {
+								if(a.si == si && a.factory_type && !a.is_upgrade)
+									++num_factories;
+							}
 							if(num_factories < int32_t(state.defines.factories_per_state)) {
-								auto new_up = fatten(state.world, state.world.force_create_state_building_construction(si, n));
-								new_up.set_is_pop_project(false);
-								new_up.set_is_upgrade(false);
-								new_up.set_type(type_selection);
+								planned.push_back(econ_construction_action{ si, dcon::province_id{}, type_selection, economy::province_building_type::railroad, false });
 								--max_projects;
 								continue;
 							} else {
@@ -1014,8 +1136,7 @@ void update_ai_econ_construction(sys::state& state) {
 			} // END if(!desired_types.empty()) {
 		} // END  if((rules & issue_rule::expand_factory) != 0 || (rules & issue_rule::build_factory) != 0)
 
-		static std::vector<dcon::province_id> project_provs;
-		project_provs.clear();
+		std::vector<dcon::province_id> project_provs;
 
 		// try naval bases
 		if(max_projects > 0) {
@@ -1051,12 +1172,7 @@ void update_ai_econ_construction(sys::state& state) {
 					return a.index() < b.index();
 			});
 			if(!project_provs.empty()) {
-				auto si = state.world.province_get_state_membership(project_provs[0]);
-				if(si)
-					si.set_naval_base_is_taken(true);
-				auto new_rr = fatten(state.world, state.world.force_create_province_building_construction(project_provs[0], n));
-				new_rr.set_is_pop_project(false);
-				new_rr.set_type(uint8_t(economy::province_building_type::naval_base));
+				planned.push_back(econ_construction_action{ dcon::state_instance_id{}, project_provs[0], dcon::factory_type_id{}, economy::province_building_type::naval_base, false });
 				--max_projects;
 			}
 		}
@@ -1098,9 +1214,7 @@ void update_ai_econ_construction(sys::state& state) {
 						return a.index() < b.index();
 				});
 				for(uint32_t j = 0; j < project_provs.size() && max_projects > 0; ++j) {
-					auto new_proj = fatten(state.world, state.world.force_create_province_building_construction(project_provs[j], n));
-					new_proj.set_is_pop_project(false);
-					new_proj.set_type(uint8_t(econ_buildable[i].type));
+					planned.push_back(econ_construction_action{ dcon::state_instance_id{}, project_provs[j], dcon::factory_type_id{}, econ_buildable[i].type, false });
 					--max_projects;
 				}
 			}
@@ -1139,13 +1253,29 @@ void update_ai_econ_construction(sys::state& state) {
 			});
 
 			for(uint32_t i = 0; i < project_provs.size() && max_projects > 0; ++i) {
-				auto new_rr = fatten(state.world, state.world.force_create_province_building_construction(project_provs[i], n));
-				new_rr.set_is_pop_project(false);
-				new_rr.set_type(uint8_t(economy::province_building_type::fort));
+				planned.push_back(econ_construction_action{ dcon::state_instance_id{}, project_provs[i], dcon::factory_type_id{}, economy::province_building_type::fort, false });
 				--max_projects;
 			}
 		}
-	}
+	});
+
+	actions.apply([&](dcon::nation_id n, econ_construction_action const& a) {
+		if(a.si) {
+			auto new_up = fatten(state.world, state.world.force_create_state_building_construction(a.si, n));
+			new_up.set_is_pop_project(false);
+			new_up.set_is_upgrade(a.is_upgrade);
+			new_up.set_type(a.factory_type);
+		} else {
+			if(a.building_type == economy::province_building_type::naval_base) {
+				auto si = state.world.province_get_state_membership(a.p);
+				if(si)
+					si.set_naval_base_is_taken(true);
+			}
+			auto new_proj = fatten(state.world, state.world.force_create_province_building_construction(a.p, n));
+			new_proj.set_is_pop_project(false);
+			new_proj.set_type(uint8_t(a.building_type));
+		}
+	});
 }
 
 void update_ai_colonial_investment(sys::state& state) {
@@ -1259,16 +1389,20 @@ void upgrade_colonies(sys::state& state) {
 
 void civilize(sys::state& state) {
 	for(auto n : state.world.in_nation) {
-		if(!n.get_is_player_controlled() && !n.get_is_civilized() && n.get_modifier_values(sys::national_mod_offsets::civilization_progress_modifier) >= 1.0f) {
+		if(!n.get_is_player_controlled() && !n.get_is_civilized() && n.get_modifier_values(sys::national_mod_offsets::civilization_progress_modifier) >= 1.0f
+			&& is_due(state, monthly_job::civilize, n)) {
 			nations::make_civilized(state, n);
 		}
 	}
 }
 
 void take_reforms(sys::state& state) {
-	for(auto n : state.world.in_nation) {
-		if(n.get_is_player_controlled() || n.get_owned_province_count() == 0)
-			continue;
+	auto issues = ve::vectorizable_buffer<dcon::issue_option_id, dcon::nation_id>(state.world.nation_size());
+	auto reforms = ve::vectorizable_buffer<dcon::reform_option_id, dcon::nation_id>(state.world.nation_size());
+	concurrency::parallel_for(uint32_t(0), state.world.nation_size(), [&](uint32_t i) {
+		auto n = fatten(state.world, dcon::nation_id{ dcon::nation_id::value_base_t(i) });
+		if(n.get_is_player_controlled() || n.get_owned_province_count() == 0 || !is_due(state, monthly_job::reforms, n))
+			return;
 
 		if(n.get_is_civilized()) { // political & social
 			// Enact social policies to deter Jacobin rebels from overruning the country
@@ -1301,9 +1435,7 @@ void take_reforms(sys::state& state) {
 					}
 				});
 			}
-			if(iss) {
-				nations::enact_issue(state, n, iss);
-			}
+			issues.set(n, iss);
 		} else { // military and economic
 			dcon::reform_option_id cheap_r;
 			float cheap_cost = 0.0f;
@@ -1331,9 +1463,15 @@ void take_reforms(sys::state& state) {
 			}
 
 			if(cheap_r && cheap_cost <= n.get_research_points()) {
-				nations::enact_reform(state, n, cheap_r);
+				reforms.set(n, cheap_r);
 			}
 		}
+	});
+	for(auto n : state.world.in_nation) {
+		if(auto iss = issues.get(n); iss)
+			nations::enact_issue(state, n, iss);
+		else if(auto r = reforms.get(n); r)
+			nations::enact_reform(state, n, r);
 	}
 }
 
@@ -1998,7 +2136,7 @@ bool valid_construction_target(sys::state& state, dcon::nation_id from, dcon::na
 void update_cb_fabrication(sys::state& state) {
 	for(auto n : state.world.in_nation) {
 		if(!n.get_is_player_controlled() && n.get_owned_province_count() > 0) {
-			if(n.get_is_at_war())
+			if(n.get_is_at_war() || !is_due(state, monthly_job::cb_fabrication, n))
 				continue;
 			// Uncivilized nations are more aggressive to westernize faster
 			float infamy_limit = state.world.nation_get_is_civilized(n) ? state.defines.badboy_limit / 2.5f : state.defines.badboy_limit;
@@ -2573,6 +2711,14 @@ void add_gw_goals(sys::state& state) {
 	}
 }
 
+struct peace_offer_action {
+	dcon::nation_id from;
+	dcon::nation_id to;
+	int32_t score_max = 0;
+	bool attacker = false;
+	bool concession = false;
+};
+
 void make_peace_offers(sys::state& state) {
 	auto send_offer_up_to = [&](dcon::nation_id from, dcon::nation_id to, dcon::war_id w, bool attacker, int32_t score_max, bool concession) {
 		if(auto off = state.world.nation_get_peace_offer_from_pending_peace_offer(from); off) {
@@ -2601,15 +2747,26 @@ void make_peace_offers(sys::state& state) {
 		command::execute_send_peace_offer(state, from);
 		};
 
-	for(auto w : state.world.in_war) {
+	// wars are looked at in parallel, and the offers then sent in war order; an offer accepted on the spot can end a
+	// war or change its leaders, in which case what was decided for it is dropped
+	static std::vector<peace_offer_action> offers;
+	offers.clear();
+	offers.resize(state.world.war_size());
+	concurrency::parallel_for(uint32_t(0), state.world.war_size(), [&](uint32_t index) {
+		auto w = fatten(state.world, dcon::war_id{ dcon::war_id::value_base_t(index) });
+		if(!state.world.war_is_valid(w))
+			return;
+		auto plan_offer = [&](dcon::nation_id from, dcon::nation_id to, bool attacker, int32_t score_max, bool concession) {
+			offers[index] = peace_offer_action{ from, to, score_max, attacker, concession };
+		};
 		if(w.get_primary_attacker().get_is_player_controlled() == false || w.get_primary_defender().get_is_player_controlled() == false) {
 			auto overall_score = military::primary_warscore(state, w);
 			if(overall_score >= 0) { // attacker winning
 				auto total_po_cost = military::attacker_peace_cost(state, w);
 				if(w.get_primary_attacker().get_is_player_controlled() == false) { // attacker makes offer
 					if(overall_score >= 100 || (overall_score >= 50 && overall_score >= total_po_cost * 2)) {
-						send_offer_up_to(w.get_primary_attacker(), w.get_primary_defender(), w, true, int32_t(overall_score), false);
-						continue;
+						plan_offer(w.get_primary_attacker(), w.get_primary_defender(), true, int32_t(overall_score), false);
+						return;
 					}
 					if(w.get_primary_defender().get_is_player_controlled() == false) {
 						auto war_duration = state.current_date.value - state.world.war_get_start_date(w).value;
@@ -2617,23 +2774,23 @@ void make_peace_offers(sys::state& state) {
 							float willingness_factor = float(war_duration - 365) * 10.0f / 365.0f;
 
 							if(overall_score > (total_po_cost - willingness_factor) && (-overall_score / 2 + total_po_cost - willingness_factor) < 0) {
-								send_offer_up_to(w.get_primary_attacker(), w.get_primary_defender(), w, true, int32_t(total_po_cost), false);
-								continue;
+								plan_offer(w.get_primary_attacker(), w.get_primary_defender(), true, int32_t(total_po_cost), false);
+								return;
 							}
 						}
 					}
 				} else if(w.get_primary_defender().get_is_player_controlled() == false) { // defender may surrender
 					if(overall_score >= 100 || (overall_score >= 50 && overall_score >= total_po_cost * 2)) {
-						send_offer_up_to(w.get_primary_defender(), w.get_primary_attacker(), w, false, int32_t(overall_score), true);
-						continue;
+						plan_offer(w.get_primary_defender(), w.get_primary_attacker(), false, int32_t(overall_score), true);
+						return;
 					}
 				}
 			} else {
 				auto total_po_cost = military::defender_peace_cost(state, w);
 				if(w.get_primary_defender().get_is_player_controlled() == false) { // defender makes offer
 					if(overall_score <= -100 || (overall_score <= -50 && overall_score <= -total_po_cost * 2)) {
-						send_offer_up_to(w.get_primary_defender(), w.get_primary_attacker(), w, false, int32_t(-overall_score), false);
-						continue;
+						plan_offer(w.get_primary_defender(), w.get_primary_attacker(), false, int32_t(-overall_score), false);
+						return;
 					}
 					if(w.get_primary_attacker().get_is_player_controlled() == false) {
 						auto war_duration = state.current_date.value - state.world.war_get_start_date(w).value;
@@ -2641,19 +2798,32 @@ void make_peace_offers(sys::state& state) {
 							float willingness_factor = float(war_duration - 365) * 10.0f / 365.0f;
 
 							if(-overall_score > (total_po_cost - willingness_factor) && (overall_score / 2 + total_po_cost - willingness_factor) < 0) {
-								send_offer_up_to(w.get_primary_defender(), w.get_primary_attacker(), w, false, int32_t(total_po_cost), false);
-								continue;
+								plan_offer(w.get_primary_defender(), w.get_primary_attacker(), false, int32_t(total_po_cost), false);
+								return;
 							}
 						}
 					}
 				} else if(w.get_primary_attacker().get_is_player_controlled() == false) { // attacker may surrender
 					if(overall_score <= -100 || (overall_score <= -50 && overall_score <= -total_po_cost * 2)) {
-						send_offer_up_to(w.get_primary_attacker(), w.get_primary_defender(), w, true, int32_t(-overall_score), true);
-						continue;
+						plan_offer(w.get_primary_attacker(), w.get_primary_defender(), true, int32_t(-overall_score), true);
+						return;
 					}
 				}
 			}
 		}
+	});
+
+	for(uint32_t i = 0; i < uint32_t(offers.size()); ++i) {
+		auto& o = offers[i];
+		if(!o.from)
+			continue;
+		dcon::war_id w{ dcon::war_id::value_base_t(i) };
+		if(!state.world.war_is_valid(w))
+			continue;
+		auto a = state.world.war_get_primary_attacker(w);
+		auto d = state.world.war_get_primary_defender(w);
+		if((o.from == a && o.to == d) || (o.from == d && o.to == a))
+			send_offer_up_to(o.from, o.to, w, o.attacker, o.score_max, o.concession);
 	}
 }
 
@@ -2883,6 +3053,8 @@ void make_war_decs(sys::state& state) {
 			return;
 		if(state.world.nation_get_is_player_controlled(n))
 			return;
+		if(!is_due(state, monthly_job::war_decs, n))
+			return;
 		if(auto ol = state.world.nation_get_overlord_as_subject(n); state.world.overlord_get_ruler(ol))
 			return;
 
@@ -3008,7 +3180,7 @@ void update_budget(sys::state& state) {
 	concurrency::parallel_for(uint32_t(0), state.world.nation_size(), [&](uint32_t i) {
 		dcon::nation_id nid{ dcon::nation_id::value_base_t(i) };
 		auto n = fatten(state.world, nid);
-		if(n.get_is_player_controlled() || n.get_owned_province_count() == 0)
+		if(n.get_is_player_controlled() || n.get_owned_province_count() == 0 || !is_due(state, monthly_job::budget, nid))
 			return;
 
 		if(n.get_is_at_war()) {
@@ -3174,12 +3346,24 @@ void update_ships(sys::state& state) {
 	}
 }
 
+struct ship_construction_action {
+	dcon::province_id port;
+	dcon::unit_type_id type;
+};
+
 void build_ships(sys::state& state) {
-	for(auto n : state.world.in_nation) {
+	static nation_actions<ship_construction_action> actions;
+	actions.reset(state);
+
+	concurrency::parallel_for(uint32_t(0), state.world.nation_size(), [&](uint32_t index) {
+		auto n = fatten(state.world, dcon::nation_id{ dcon::nation_id::value_base_t(index) });
+		auto& planned = actions[n];
+		if(!is_due(state, monthly_job::ships, n))
+			return;
 		if(!n.get_is_player_controlled() && n.get_province_naval_construction().begin() == n.get_province_naval_construction().end()) {
 			auto disarm = n.get_disarmed_until();
 			if(disarm && state.current_date < disarm)
-				continue;
+				return;
 
 			dcon::unit_type_id best_transport;
 			dcon::unit_type_id best_light;
@@ -3224,8 +3408,7 @@ void build_ships(sys::state& state) {
 				}
 			}
 
-			static std::vector<dcon::province_id> owned_ports;
-			owned_ports.clear();
+			std::vector<dcon::province_id> owned_ports;
 			for(auto p : n.get_province_ownership()) {
 				if(p.get_province().get_is_coast() && p.get_province().get_nation_from_province_control() == n) {
 					owned_ports.push_back(p.get_province().id);
@@ -3252,8 +3435,7 @@ void build_ships(sys::state& state) {
 						if((overseas_allowed || !province::is_overseas(state, owned_ports[j]))
 							&& state.world.province_get_building_level(owned_ports[j], economy::province_building_type::naval_base) >= level_req) {
 
-							auto c = fatten(state.world, state.world.try_create_province_naval_construction(owned_ports[j], n));
-							c.set_type(best_transport);
+							planned.push_back(ship_construction_action{ owned_ports[j], best_transport });
 							constructing_fleet_cap += supply_pts;
 						}
 					}
@@ -3266,8 +3448,7 @@ void build_ships(sys::state& state) {
 						if((overseas_allowed || !province::is_overseas(state, owned_ports[j]))
 							&& state.world.province_get_building_level(owned_ports[j], economy::province_building_type::naval_base) >= level_req) {
 
-							auto c = fatten(state.world, state.world.try_create_province_naval_construction(owned_ports[j], n));
-							c.set_type(best_transport);
+							planned.push_back(ship_construction_action{ owned_ports[j], best_transport });
 							++num_transports;
 							constructing_fleet_cap += supply_pts;
 						}
@@ -3292,8 +3473,7 @@ void build_ships(sys::state& state) {
 					if((overseas_allowed || !province::is_overseas(state, owned_ports[j]))
 						&& state.world.province_get_building_level(owned_ports[j], economy::province_building_type::naval_base) >= level_req) {
 
-						auto c = fatten(state.world, state.world.try_create_province_naval_construction(owned_ports[j], n));
-						c.set_type(best_light);
+						planned.push_back(ship_construction_action{ owned_ports[j], best_light });
 						free_small_points -= supply_pts;
 					}
 				}
@@ -3307,14 +3487,18 @@ void build_ships(sys::state& state) {
 					if((overseas_allowed || !province::is_overseas(state, owned_ports[j]))
 						&& state.world.province_get_building_level(owned_ports[j], economy::province_building_type::naval_base) >= level_req) {
 
-						auto c = fatten(state.world, state.world.try_create_province_naval_construction(owned_ports[j], n));
-						c.set_type(best_big);
+						planned.push_back(ship_construction_action{ owned_ports[j], best_big });
 						free_big_points -= supply_pts;
 					}
 				}
 			}
 		}
-	}
+	});
+
+	actions.apply([&](dcon::nation_id n, ship_construction_action const& a) {
+		auto c = fatten(state.world, state.world.try_create_province_naval_construction(a.port, n));
+		c.set_type(a.type);
+	});
 }
 
 dcon::province_id get_home_port(sys::state& state, dcon::nation_id n) {
@@ -3920,6 +4104,7 @@ dcon::navy_id find_transport_fleet(sys::state& state, dcon::nation_id controller
 void move_idle_guards(sys::state& state) {
 	std::vector<dcon::army_id> require_transport;
 	require_transport.reserve(state.world.army_size());
+	std::vector<dcon::province_id> path;
 
 	for(auto ar : state.world.in_army) {
 		if(ar.get_ai_activity() == uint8_t(army_activity::on_guard)
@@ -3931,7 +4116,10 @@ void move_idle_guards(sys::state& state) {
 			&& !ar.get_battle_from_army_battle_participation()
 			&& !ar.get_navy_from_army_transport()) {
 
-			auto path = ar.get_black_flag() ? province::make_unowned_land_path(state, ar.get_location_from_army_location(), ar.get_ai_province()) : province::make_land_path(state, ar.get_location_from_army_location(), ar.get_ai_province(), ar.get_controller_from_army_control(), ar);
+			if(ar.get_black_flag())
+				province::make_unowned_land_path(state, ar.get_location_from_army_location(), ar.get_ai_province(), path);
+			else
+				province::make_land_path(state, ar.get_location_from_army_location(), ar.get_ai_province(), ar.get_controller_from_army_control(), ar, path);
 			if(path.size() > 0) {
 				auto existing_path = ar.get_path();
 				auto new_size = uint32_t(path.size());
@@ -3973,9 +4161,10 @@ void move_idle_guards(sys::state& state) {
 		}
 
 		if(!state.world.province_get_is_coast(coastal_target_prov)) {
-			auto path = state.world.army_get_black_flag(require_transport[i])
-				? province::make_unowned_path_to_nearest_coast(state, coastal_target_prov)
-				: province::make_path_to_nearest_coast(state, controller, coastal_target_prov);
+			if(state.world.army_get_black_flag(require_transport[i]))
+				province::make_unowned_path_to_nearest_coast(state, coastal_target_prov, path);
+			else
+				province::make_path_to_nearest_coast(state, controller, coastal_target_prov, path);
 			if(path.empty()) {
 				state.world.army_set_ai_province(require_transport[i], dcon::province_id{}); // stop rechecking unit
 				continue; // army could not reach coast
@@ -4034,19 +4223,20 @@ void move_idle_guards(sys::state& state) {
 						state.world.army_set_ai_activity(require_transport[i], uint8_t(army_activity::transport_guard));
 						tcap -= int32_t(jregs.end() - jregs.begin());
 					} else {
-						auto jpath = state.world.army_get_black_flag(require_transport[j])
-							? province::make_land_path(state, state.world.army_get_location_from_army_location(require_transport[j]), coastal_target_prov, controller, require_transport[j])
-							: province::make_unowned_land_path(state, state.world.army_get_location_from_army_location(require_transport[j]), coastal_target_prov);
-						if(!jpath.empty()) {
+						if(state.world.army_get_black_flag(require_transport[j]))
+							province::make_land_path(state, state.world.army_get_location_from_army_location(require_transport[j]), coastal_target_prov, controller, require_transport[j], path);
+						else
+							province::make_unowned_land_path(state, state.world.army_get_location_from_army_location(require_transport[j]), coastal_target_prov, path);
+						if(!path.empty()) {
 							auto existing_path = state.world.army_get_path(require_transport[j]);
-							auto new_size = uint32_t(jpath.size());
+							auto new_size = uint32_t(path.size());
 							existing_path.resize(new_size);
 
 							for(uint32_t k = 0; k < new_size; ++k) {
-								assert(jpath[k]);
-								existing_path[k] = jpath[k];
+								assert(path[k]);
+								existing_path[k] = path[k];
 							}
-							state.world.army_set_arrival_time(require_transport[j], military::arrival_time_to(state, require_transport[j], jpath.back()));
+							state.world.army_set_arrival_time(require_transport[j], military::arrival_time_to(state, require_transport[j], path.back()));
 							state.world.army_set_dig_in(require_transport[j], 0);
 							state.world.army_set_ai_activity(require_transport[i], uint8_t(army_activity::transport_guard));
 							tcap -= int32_t(jregs.end() - jregs.begin());
@@ -4220,6 +4410,7 @@ float estimate_attack_force(sys::state& state, dcon::province_id target, dcon::n
 void assign_targets(sys::state& state, dcon::nation_id n) {
 	std::vector<dcon::province_id> ready_armies;
 	ready_armies.reserve(state.world.province_size());
+	std::vector<dcon::province_id> path;
 
 	int32_t ready_count = 0;
 	for(auto ar : state.world.nation_get_army_control(n)) {
@@ -4247,6 +4438,7 @@ void assign_targets(sys::state& state, dcon::nation_id n) {
 	struct army_target {
 		float minimal_distance;
 		dcon::province_id location;
+		bool reachable = true; // over land, from one of the ready armies
 	};
 
 	/* Ourselves */
@@ -4302,7 +4494,17 @@ void assign_targets(sys::state& state, dcon::nation_id n) {
 		}
 	}
 
+	// targets are ranked by travel distance from the closest ready army; the ones that cannot be reached
+	// over land come last, ranked by straight line distance
+	// make_attacks runs this from a parallel loop, so each thread keeps its own field
+	static thread_local province::land_distance_field travel_distance;
+	province::make_land_distance_field(state, n, ready_armies, travel_distance);
 	for(auto& pt : potential_targets) {
+		if(travel_distance.is_reachable(pt.location)) {
+			pt.minimal_distance = travel_distance.get(pt.location);
+			continue;
+		}
+		pt.reachable = false;
 		for(uint32_t i = uint32_t(ready_armies.size()); i-- > 1;) {
 			auto sdist = province::sorting_distance(state, ready_armies[i], pt.location);
 			if(sdist < pt.minimal_distance) {
@@ -4311,6 +4513,8 @@ void assign_targets(sys::state& state, dcon::nation_id n) {
 		}
 	}
 	std::sort(potential_targets.begin(), potential_targets.end(), [&](army_target& a, army_target& b) {
+		if(a.reachable != b.reachable)
+			return a.reachable;
 		if(a.minimal_distance != b.minimal_distance)
 			return a.minimal_distance < b.minimal_distance;
 		else
@@ -4402,7 +4606,7 @@ void assign_targets(sys::state& state, dcon::nation_id n) {
 				if(ready_armies[m] == central_province) {
 					ar.get_army().set_ai_province(potential_targets[i].location);
 					ar.get_army().set_ai_activity(uint8_t(army_activity::attacking));
-				} else if(auto path = province::make_safe_land_path(state, ready_armies[m], central_province, n); !path.empty()) {
+				} else if(province::make_safe_land_path(state, ready_armies[m], central_province, n, path)) {
 					auto existing_path = ar.get_army().get_path();
 					auto new_size = uint32_t(path.size());
 					existing_path.resize(new_size);
@@ -4453,6 +4657,7 @@ void make_defense(sys::state& state) {
 void move_gathered_attackers(sys::state& state) {
 	static std::vector<dcon::army_id> require_transport;
 	require_transport.clear();
+	static std::vector<dcon::province_id> path;
 
 	for(auto ar : state.world.in_army) {
 		if(ar.get_ai_activity() == uint8_t(army_activity::attack_transport)) {
@@ -4482,7 +4687,7 @@ void move_gathered_attackers(sys::state& state) {
 					}
 				} else {
 					if(province::has_access_to_province(state, ar.get_controller_from_army_control(), ar.get_ai_province())) {
-						if(auto path = province::make_land_path(state, ar.get_location_from_army_location(), ar.get_ai_province(), ar.get_controller_from_army_control(), ar); path.size() > 0) {
+						if(province::make_land_path(state, ar.get_location_from_army_location(), ar.get_ai_province(), ar.get_controller_from_army_control(), ar, path)) {
 
 							auto existing_path = ar.get_path();
 							auto new_size = uint32_t(path.size());
@@ -4539,7 +4744,7 @@ void move_gathered_attackers(sys::state& state) {
 								o.get_army().set_ai_activity(uint8_t(army_activity::attack_gathered));
 							}
 						}
-					} else if(auto path = province::make_land_path(state, ar.get_location_from_army_location(), ar.get_ai_province(), ar.get_controller_from_army_control(), ar); path.size() > 0) {
+					} else if(province::make_land_path(state, ar.get_location_from_army_location(), ar.get_ai_province(), ar.get_controller_from_army_control(), ar, path)) {
 
 						for(auto o : ar.get_location_from_army_location().get_army_location()) {
 							if(o.get_army().get_ai_province() == ar.get_ai_province()
@@ -4602,8 +4807,7 @@ void move_gathered_attackers(sys::state& state) {
 		}
 
 		if(!state.world.province_get_is_coast(coastal_target_prov)) {
-			auto path = province::make_path_to_nearest_coast(state, controller, coastal_target_prov);
-			if(path.empty()) {
+			if(!province::make_path_to_nearest_coast(state, controller, coastal_target_prov, path)) {
 				state.world.army_set_ai_activity(require_transport[i], uint8_t(army_activity::on_guard));
 				state.world.army_set_ai_province(require_transport[i], dcon::province_id{});
 				continue; // army could not reach coast
@@ -4661,19 +4865,20 @@ void move_gathered_attackers(sys::state& state) {
 						state.world.army_set_ai_activity(require_transport[i], uint8_t(army_activity::transport_attack));
 						tcap -= int32_t(jregs.end() - jregs.begin());
 					} else {
-						auto jpath = state.world.army_get_black_flag(require_transport[j])
-							? province::make_land_path(state, state.world.army_get_location_from_army_location(require_transport[j]), coastal_target_prov, controller, require_transport[j])
-							: province::make_unowned_land_path(state, state.world.army_get_location_from_army_location(require_transport[j]), coastal_target_prov);
-						if(!jpath.empty()) {
+						if(state.world.army_get_black_flag(require_transport[j]))
+							province::make_land_path(state, state.world.army_get_location_from_army_location(require_transport[j]), coastal_target_prov, controller, require_transport[j], path);
+						else
+							province::make_unowned_land_path(state, state.world.army_get_location_from_army_location(require_transport[j]), coastal_target_prov, path);
+						if(!path.empty()) {
 							auto existing_path = state.world.army_get_path(require_transport[j]);
-							auto new_size = uint32_t(jpath.size());
+							auto new_size = uint32_t(path.size());
 							existing_path.resize(new_size);
 
 							for(uint32_t k = 0; k < new_size; ++k) {
-								assert(jpath[k]);
-								existing_path[k] = jpath[k];
+								assert(path[k]);
+								existing_path[k] = path[k];
 							}
-							state.world.army_set_arrival_time(require_transport[j], military::arrival_time_to(state, require_transport[j], jpath.back()));
+							state.world.army_set_arrival_time(require_transport[j], military::arrival_time_to(state, require_transport[j], path.back()));
 							state.world.army_set_dig_in(require_transport[j], 0);
 							state.world.army_set_ai_activity(require_transport[i], uint8_t(army_activity::transport_attack));
 							tcap -= int32_t(jregs.end() - jregs.begin());
@@ -4688,17 +4893,28 @@ void move_gathered_attackers(sys::state& state) {
 	}
 }
 
+struct land_construction_action {
+	dcon::pop_id pop; // a new regiment from this pop ...
+	dcon::regiment_id regiment; // ... or this irregular regiment turned into infantry
+	dcon::unit_type_id type;
+};
+
 void update_land_constructions(sys::state& state) {
-	for(auto n : state.world.in_nation) {
-		if(n.get_is_player_controlled() || n.get_owned_province_count() == 0)
-			continue;
+	static nation_actions<land_construction_action> actions;
+	actions.reset(state);
+
+	concurrency::parallel_for(uint32_t(0), state.world.nation_size(), [&](uint32_t index) {
+		auto n = fatten(state.world, dcon::nation_id{ dcon::nation_id::value_base_t(index) });
+		auto& planned = actions[n];
+		if(n.get_is_player_controlled() || n.get_owned_province_count() == 0 || !is_due(state, monthly_job::land_units, n))
+			return;
 		auto disarm = n.get_disarmed_until();
 		if(disarm && state.current_date < disarm)
-			continue;
+			return;
 
 		auto constructions = state.world.nation_get_province_land_construction(n);
 		if(constructions.begin() != constructions.end())
-			continue;
+			return;
 
 		int32_t num_frontline = 0;
 		int32_t num_support = 0;
@@ -4716,7 +4932,7 @@ void update_land_constructions(sys::state& state) {
 					++num_frontline;
 				}
 				if(can_make_inf && type == state.military_definitions.irregular) { // free ai upgrades
-					r.get_regiment().set_type(state.military_definitions.infantry);
+					planned.push_back(land_construction_action{ dcon::pop_id{}, r.get_regiment().id, state.military_definitions.infantry });
 				}
 			}
 		}
@@ -4752,8 +4968,7 @@ void update_land_constructions(sys::state& state) {
 								auto num_to_make = amount - ((regs.end() - regs.begin()) + (building.end() - building.begin()));
 
 								while(num_to_make > 0) {
-									auto c = fatten(state.world, state.world.try_create_province_land_construction(pop.get_pop().id, n));
-									c.set_type(decide_type());
+									planned.push_back(land_construction_action{ pop.get_pop().id, dcon::regiment_id{}, decide_type() });
 									--num_to_make;
 								}
 							}
@@ -4773,8 +4988,7 @@ void update_land_constructions(sys::state& state) {
 								auto num_to_make = amount - ((regs.end() - regs.begin()) + (building.end() - building.begin()));
 
 								while(num_to_make > 0) {
-									auto c = fatten(state.world, state.world.try_create_province_land_construction(pop.get_pop().id, n));
-									c.set_type(decide_type());
+									planned.push_back(land_construction_action{ pop.get_pop().id, dcon::regiment_id{}, decide_type() });
 									--num_to_make;
 								}
 							}
@@ -4794,8 +5008,7 @@ void update_land_constructions(sys::state& state) {
 								auto num_to_make = amount - ((regs.end() - regs.begin()) + (building.end() - building.begin()));
 
 								while(num_to_make > 0) {
-									auto c = fatten(state.world, state.world.try_create_province_land_construction(pop.get_pop().id, n));
-									c.set_type(decide_type());
+									planned.push_back(land_construction_action{ pop.get_pop().id, dcon::regiment_id{}, decide_type() });
 									--num_to_make;
 								}
 							}
@@ -4803,7 +5016,16 @@ void update_land_constructions(sys::state& state) {
 					}
 				}
 			}
-	}
+	});
+
+	actions.apply([&](dcon::nation_id n, land_construction_action const& a) {
+		if(a.regiment) {
+			state.world.regiment_set_type(a.regiment, a.type);
+		} else {
+			auto c = fatten(state.world, state.world.try_create_province_land_construction(a.pop, n));
+			c.set_type(a.type);
+		}
+	});
 }
 
 void new_units_and_merging(sys::state& state) {
@@ -5,6 +5,33 @@
 
 namespace ai {
 
+// The monthly per-nation ai jobs. Instead of all nations doing a job on one fixed day, each nation does it on a day of
+// its own (see update_monthly_schedule)
+enum class monthly_job : uint8_t {
+	research, budget, ships, land_units, econ_construction, reforms, civilize, war_decs, cb_fabrication, ruling_party, count
+};
+
+struct monthly_schedule {
+	std::vector<uint32_t> pairs; // job << 16 | nation, grouped by day
+	std::vector<uint32_t> day_start; // per day of the month, the first of its pairs, plus one at the end
+	std::vector<uint32_t> fill; // scratch
+	int32_t month = -1; // year * 12 + month the pairs were made for
+	std::vector<uint64_t> due; // per job, a row of bits by nation
+	uint32_t words_per_job = 0;
+	uint32_t due_today = 0; // nation-job pairs handed out today, for diagnostics
+	bool in_use = false; // outside of the scheduled part of the tick every nation is due
+};
+
+// Works out which nations do which jobs today. Every (nation, job) pair gets a day of the month from a hash; with a
+// budget (the alice_ai_daily_job_budget define, or an even share of the month's work when it is 0) the pairs over it
+// are carried over to the next day in a fixed order, and the last day of the month takes whatever is left. The pairs are
+// made once, for the ai nations of the first day of the month, so that nations dying or changing hands do not move the
+// others to other days; nations appearing later in the month wait for the next one. They are saved with the game, so
+// that a client joining mid-month agrees with the host
+void update_monthly_schedule(sys::state& state);
+void end_monthly_schedule(sys::state& state);
+bool is_due(sys::state const& state, monthly_job j, dcon::nation_id n);
+
 void update_ai_general_status(sys::state& state);
 void form_alliances(sys::state& state);
 void prune_alliances(sys::state& state);
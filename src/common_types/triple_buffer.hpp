@@ -0,0 +1,35 @@
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+namespace sys {
+
+// A value handed from one thread to another without either of them waiting. The writer fills write_buffer() and
+// calls publish(); the reader calls read() and gets the latest published value, which the writer won't touch again
+// until the reader has moved on to a newer one
+template<typename T>
+class triple_buffer {
+	static constexpr uint8_t index_mask = 0x03;
+	static constexpr uint8_t fresh_bit = 0x04;
+
+	T buffers[3];
+	std::atomic<uint8_t> middle = 1;
+	uint8_t back = 0;  // owned by the writer
+	uint8_t front = 2; // owned by the reader
+
+public:
+	T& write_buffer() {
+		return buffers[back];
+	}
+	void publish() {
+		back = uint8_t(middle.exchange(uint8_t(back | fresh_bit), std::memory_order::acq_rel) & index_mask);
+	}
+	T const& read() {
+		if((middle.load(std::memory_order::acquire) & fresh_bit) != 0)
+			front = uint8_t(middle.exchange(front, std::memory_order::acq_rel) & index_mask);
+		return buffers[front];
+	}
+};
+
+} // namespace sys
@@ -330,6 +330,7 @@ void force_nation_ideology(sys::state& state, dcon::nation_id n, dcon::ideology_
 }
 
 void update_displayed_identity(sys::state& state, dcon::nation_id id) {
+	++state.ownership_epoch;
 	auto ident = state.world.nation_get_identity_from_identity_holder(id);
 	auto gov_id = state.world.nation_get_government_type(id);
 	assert(!gov_id || state.world.government_type_is_valid(gov_id));
@@ -917,6 +917,7 @@ void rebel_risings_check(sys::state& state) {
 							auto new_army = fatten(state.world, state.world.create_army());
 							new_army.set_controller_from_army_rebel_control(rf);
 							new_army.set_location_from_army_location(pop_location);
+							military::note_army_presence(state, new_army, pop_location);
 							new_armies.push_back(new_army);
 							return new_army.id;
 						}();
@@ -3768,6 +3768,7 @@ void resolve_constructions(sys::state& state) {
 					auto a = fatten(state.world, state.world.create_navy());
 					a.set_controller_from_navy_control(c.get_nation());
 					a.set_location_from_navy_location(p);
+					military::note_navy_presence(state, a, p);
 					state.world.try_create_navy_membership(new_ship, a);
 					military::move_navy_to_merge(state, c.get_nation(), a, c.get_province(), c.get_template_province());
 
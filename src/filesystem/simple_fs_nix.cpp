@@ -408,6 +408,13 @@ native_string get_file_name(unopened_file const& f) {
 	return f.file_name;
 }
 
+uint64_t get_last_write_time(unopened_file const& f) {
+	struct stat sb;
+	if(stat(f.absolute_path.c_str(), &sb) == -1)
+		return 0;
+	return uint64_t(sb.st_mtim.tv_sec) * 1000000000 + uint64_t(sb.st_mtim.tv_nsec);
+}
+
 native_string get_full_name(file const& f) {
 	return f.absolute_path;
 }
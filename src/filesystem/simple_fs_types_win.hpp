@@ -70,6 +70,7 @@ public:
 	friend std::vector<unopened_file> list_files(directory const& dir, native_char const* extension);
 	friend native_string get_full_name(unopened_file const& f);
 	friend native_string get_file_name(unopened_file const& f);
+	friend uint64_t get_last_write_time(unopened_file const& f);
 };
 
 class file {
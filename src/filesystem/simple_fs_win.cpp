@@ -331,6 +331,13 @@ native_string get_file_name(unopened_file const& f) {
 	return f.file_name;
 }
 
+uint64_t get_last_write_time(unopened_file const& f) {
+	WIN32_FILE_ATTRIBUTE_DATA data;
+	if(!GetFileAttributesExW(f.absolute_path.c_str(), GetFileExInfoStandard, &data))
+		return 0;
+	return (uint64_t(data.ftLastWriteTime.dwHighDateTime) << 32) | uint64_t(data.ftLastWriteTime.dwLowDateTime);
+}
+
 native_string get_full_name(file const& f) {
 	return f.absolute_path;
 }
@@ -861,6 +861,7 @@ void execute_make_vassal(sys::state& state, dcon::nation_id source, dcon::nation
 	nations::liberate_nation_from(state, t, source);
 	auto holder = state.world.national_identity_get_nation_from_identity_holder(t);
 	state.world.force_create_overlord(holder, source);
+	province::invalidate_land_access(state, source);
 	if(state.world.nation_get_is_great_power(source)) {
 		auto sr = state.world.force_create_gp_relationship(holder, source);
 		auto& flags = state.world.gp_relationship_get_status(sr);
@@ -1420,6 +1421,7 @@ void execute_add_to_sphere(sys::state& state, dcon::nation_id source, dcon::nati
 	l = nations::influence::increase_level(l);
 
 	state.world.nation_set_in_sphere_of(influence_target, source);
+	province::invalidate_land_access(state, source);
 
 	notification::post(state, notification::message{
 		[source, influence_target](sys::state& state, text::layout_base& contents) {
@@ -1485,6 +1487,7 @@ void execute_remove_from_sphere(sys::state& state, dcon::nation_id source, dcon:
 	state.world.gp_relationship_get_influence(rel) -= state.defines.removefromsphere_influence_cost;
 
 	state.world.nation_set_in_sphere_of(influence_target, dcon::nation_id{});
+	province::invalidate_land_access(state, affected_gp);
 
 	auto orel = state.world.get_gp_relationship_by_gp_influence_pair(influence_target, affected_gp);
 	auto& l = state.world.gp_relationship_get_status(orel);
@@ -2240,11 +2243,7 @@ bool can_give_military_access(sys::state& state, dcon::nation_id asker, dcon::na
 void execute_give_military_access(sys::state& state, dcon::nation_id asker, dcon::nation_id target) {
 	state.world.nation_get_diplomatic_points(asker) -= state.defines.givemilaccess_diplomatic_cost;
 
-	auto urel = state.world.get_unilateral_relationship_by_unilateral_pair(asker, target);
-	if(!urel) {
-		urel = state.world.force_create_unilateral_relationship(asker, target);
-	}
-	state.world.unilateral_relationship_set_military_access(urel, true);
+	military::give_military_access(state, target, asker);
 	nations::adjust_relationship(state, asker, target, state.defines.givemilaccess_relation_on_accept);
 }
 
@@ -2450,9 +2449,7 @@ bool can_cancel_military_access(sys::state& state, dcon::nation_id source, dcon:
 		return false;
 }
 void execute_cancel_military_access(sys::state& state, dcon::nation_id source, dcon::nation_id target) {
-	auto rel = state.world.get_unilateral_relationship_by_unilateral_pair(target, source);
-	if(rel)
-		state.world.unilateral_relationship_set_military_access(rel, false);
+	military::remove_military_access(state, source, target);
 
 	state.world.nation_get_diplomatic_points(source) -= state.defines.cancelaskmilaccess_diplomatic_cost;
 	nations::adjust_relationship(state, source, target, state.defines.cancelaskmilaccess_relation_on_accept);
@@ -2487,9 +2484,7 @@ bool can_cancel_given_military_access(sys::state& state, dcon::nation_id source,
 		return false;
 }
 void execute_cancel_given_military_access(sys::state& state, dcon::nation_id source, dcon::nation_id target) {
-	auto rel = state.world.get_unilateral_relationship_by_unilateral_pair(source, target);
-	if(rel)
-		state.world.unilateral_relationship_set_military_access(rel, false);
+	military::remove_military_access(state, target, source);
 
 	state.world.nation_get_diplomatic_points(source) -= state.defines.cancelgivemilaccess_diplomatic_cost;
 	nations::adjust_relationship(state, source, target, state.defines.cancelgivemilaccess_relation_on_accept);
@@ -3665,6 +3660,7 @@ void execute_evenly_split_army(sys::state& state, dcon::nation_id source, dcon::
 		new_u.set_controller_from_army_control(source);
 		new_u.set_location_from_army_location(state.world.army_get_location_from_army_location(a));
 		new_u.set_black_flag(state.world.army_get_black_flag(a));
+		military::note_army_presence(state, new_u, state.world.army_get_location_from_army_location(a));
 
 		for(auto t : to_transfer) {
 			state.world.regiment_set_army_from_army_membership(t, new_u);
@@ -3718,6 +3714,7 @@ void execute_evenly_split_navy(sys::state& state, dcon::nation_id source, dcon::
 		auto new_u = fatten(state.world, state.world.create_navy());
 		new_u.set_controller_from_navy_control(source);
 		new_u.set_location_from_navy_location(state.world.navy_get_location_from_navy_location(a));
+		military::note_navy_presence(state, new_u, state.world.navy_get_location_from_navy_location(a));
 
 		for(auto t : to_transfer) {
 			state.world.ship_set_navy_from_navy_membership(t, new_u);
@@ -3756,6 +3753,7 @@ void execute_split_army(sys::state& state, dcon::nation_id source, dcon::army_id
 		new_u.set_controller_from_army_control(source);
 		new_u.set_location_from_army_location(state.world.army_get_location_from_army_location(a));
 		new_u.set_black_flag(state.world.army_get_black_flag(a));
+		military::note_army_presence(state, new_u, state.world.army_get_location_from_army_location(a));
 
 		for(auto t : to_transfer) {
 			state.world.regiment_set_army_from_army_membership(t, new_u);
@@ -3804,6 +3802,7 @@ void execute_split_navy(sys::state& state, dcon::nation_id source, dcon::navy_id
 		auto new_u = fatten(state.world, state.world.create_navy());
 		new_u.set_controller_from_navy_control(source);
 		new_u.set_location_from_navy_location(state.world.navy_get_location_from_navy_location(a));
+		military::note_navy_presence(state, new_u, state.world.navy_get_location_from_navy_location(a));
 
 		for(auto t : to_transfer) {
 			state.world.ship_set_navy_from_navy_membership(t, new_u);
@@ -4318,41 +4317,24 @@ void execute_notify_player_oos(sys::state& state, dcon::nation_id source) {
 	post_chat_message(state, m);
 }
 
-void advance_tick(sys::state& state, dcon::nation_id source) {
-	payload p;
-	memset(&p, 0, sizeof(payload));
-	p.type = command::command_type::advance_tick;
-	p.source = source;
-	// Postponed until it is sent!
-	//p.data.advance_tick.checksum = state.get_save_checksum();
-	p.data.advance_tick.speed = state.actual_game_speed.load(std::memory_order::acquire);
-	add_to_command_queue(state, p);
-}
-
-void execute_advance_tick(sys::state& state, dcon::nation_id source, sys::checksum_key& k, int32_t speed) {
+void execute_advance_tick(sys::state& state, dcon::nation_id source, sys::checksum_key& k, int32_t speed, sys::date target) {
 	if(state.network_mode == sys::network_mode_type::client) {
-#ifndef NDEBUG //Debug - daily oos check
-		if(!state.network_state.out_of_sync) {
+		/* Lockstep frame: run all the ticks the host has already run, the inputs of later ticks
+		   always come after the frame that reaches them */
+		auto frame_start = state.current_date;
+		state.actual_game_speed = speed;
+		while(state.current_date < target && state.mode != sys::game_mode_type::end_screen) {
+			state.single_game_tick();
+		}
+		if(!state.network_state.out_of_sync && network::frame_needs_checksum(state, frame_start, target)) {
 			sys::checksum_key current = state.get_save_checksum();
+			network::record_tick_checksum(state, state.current_date, current);
 			if(!current.is_equal(k)) {
 				state.network_state.out_of_sync = true;
 				state.debug_save_oos_dump();
 			}
 		}
-#else //Release - monthly oos check
-		if(state.current_date.to_ymd(state.start_date).day == 1) {
-			if(!state.network_state.out_of_sync) {
-				sys::checksum_key current = state.get_save_checksum();
-				if(!current.is_equal(k)) {
-					state.network_state.out_of_sync = true;
-					state.debug_save_oos_dump();
-				}
-			}
-		}
-#endif
-		state.actual_game_speed = speed;
 	}
-	state.single_game_tick();
 }
 
 void notify_save_loaded(sys::state& state, dcon::nation_id source) {
@@ -4379,8 +4361,9 @@ void execute_notify_start_game(sys::state& state, dcon::nation_id source) {
 	state.selected_armies.clear();
 	state.selected_navies.clear();
 	/* And clear the save stuff */
-	state.network_state.current_save_buffer.reset();
-	state.network_state.current_save_length = 0;
+	network::clear_network_save(state);
+	/* Lockstep frames start from here */
+	state.network_state.last_frame_date = state.current_date;
 	/* Clear AI data */
 	for(const auto n : state.world.in_nation)
 		if(state.world.nation_get_is_player_controlled(n))
@@ -5105,7 +5088,7 @@ void execute_command(sys::state& state, payload& c) {
 		execute_notify_player_oos(state, c.source);
 		break;
 	case command_type::advance_tick:
-		execute_advance_tick(state, c.source, c.data.advance_tick.checksum, c.data.advance_tick.speed);
+		execute_advance_tick(state, c.source, c.data.advance_tick.checksum, c.data.advance_tick.speed, c.data.advance_tick.date);
 		break;
 	case command_type::notify_save_loaded:
 		execute_notify_save_loaded(state, c.source, c.data.notify_save_loaded.checksum);
@@ -5198,6 +5181,7 @@ void execute_pending_commands(sys::state& state) {
 		province::update_connected_regions(state);
 		province::update_cached_values(state);
 		nations::update_cached_values(state);
+		state.publish_ui_snapshot();
 		state.game_state_updated.store(true, std::memory_order::release);
 	}
 }
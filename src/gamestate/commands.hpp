@@ -431,8 +431,9 @@ struct nation_pick_data {
 };
 
 struct advance_tick_data {
-	sys::checksum_key checksum;
+	sys::checksum_key checksum; // of the state at date, only filled in if network::frame_needs_checksum
 	int32_t speed;
+	sys::date date; // lockstep frame: clients advance up to this date
 };
 
 struct notify_save_loaded_data {
@@ -502,7 +503,9 @@ struct payload {
 		dtype() { }
 	} data;
 	dcon::nation_id source;
+	sys::date tick; // date the host executed this command on, if has_tick is set
 	command_type type = command_type::invalid;
+	bool has_tick = false;
 
 	payload() { }
 };
@@ -809,7 +812,6 @@ bool can_release_subject(sys::state& state, dcon::nation_id source, dcon::nation
 void state_transfer(sys::state& state, dcon::nation_id asker, dcon::nation_id target, dcon::state_definition_id sid);
 bool can_state_transfer(sys::state& state, dcon::nation_id asker, dcon::nation_id target, dcon::state_definition_id sid);
 
-void advance_tick(sys::state& state, dcon::nation_id source);
 void notify_player_ban(sys::state& state, dcon::nation_id source, dcon::nation_id target);
 bool can_notify_player_ban(sys::state& state, dcon::nation_id source, dcon::nation_id target);
 void notify_player_kick(sys::state& state, dcon::nation_id source, dcon::nation_id target);
@@ -3,6 +3,7 @@
 #include "serialization.hpp"
 #include <random>
 #include <ctime>
+#include <mutex>
 
 #define ZSTD_STATIC_LINKING_ONLY
 #define XXH_NAMESPACE ZSTD_
@@ -696,6 +697,9 @@ uint8_t const* read_save_section(uint8_t const* ptr_in, uint8_t const* section_e
 	ptr_in = memcpy_deserialize(ptr_in, state.player_data_cache);
 	ptr_in = deserialize(ptr_in, state.future_n_event);
 	ptr_in = deserialize(ptr_in, state.future_p_event);
+	ptr_in = deserialize(ptr_in, state.ai_schedule.pairs);
+	ptr_in = deserialize(ptr_in, state.ai_schedule.day_start);
+	ptr_in = memcpy_deserialize(ptr_in, state.ai_schedule.month);
 
 	{ // national definitions
 		ptr_in = deserialize(ptr_in, state.national_definitions.global_flag_variables);
@@ -744,6 +748,9 @@ uint8_t* write_save_section(uint8_t* ptr_in, sys::state& state) {
 	ptr_in = memcpy_serialize(ptr_in, state.player_data_cache);
 	ptr_in = serialize(ptr_in, state.future_n_event);
 	ptr_in = serialize(ptr_in, state.future_p_event);
+	ptr_in = serialize(ptr_in, state.ai_schedule.pairs);
+	ptr_in = serialize(ptr_in, state.ai_schedule.day_start);
+	ptr_in = memcpy_serialize(ptr_in, state.ai_schedule.month);
 
 	{ // national definitions
 		ptr_in = serialize(ptr_in, state.national_definitions.global_flag_variables);
@@ -792,6 +799,9 @@ size_t sizeof_save_section(sys::state& state) {
 	sz += sizeof(state.player_data_cache);
 	sz += serialize_size(state.future_n_event);
 	sz += serialize_size(state.future_p_event);
+	sz += serialize_size(state.ai_schedule.pairs);
+	sz += serialize_size(state.ai_schedule.day_start);
+	sz += sizeof(state.ai_schedule.month);
 
 	{ // national definitions
 		sz += serialize_size(state.national_definitions.global_flag_variables);
@@ -980,6 +990,47 @@ bool try_read_scenario_as_save_file(sys::state& state, native_string_view name)
 	}
 }
 
+bool try_read_scenario_save_section(sys::state& state, native_string_view name, std::vector<uint8_t>& section_out) {
+	auto dir = simple_fs::get_or_create_scenario_directory();
+	auto save_file = open_file(dir, name);
+	if(save_file) {
+		scenario_header header;
+		header.version = 0;
+
+		auto contents = simple_fs::view_contents(*save_file);
+		uint8_t const* buffer_pos = reinterpret_cast<uint8_t const*>(contents.data);
+
+		if(contents.file_size > sizeof_scenario_header(header)) {
+			buffer_pos = read_scenario_header(buffer_pos, header);
+		}
+
+		if(header.version != sys::scenario_file_version) {
+			return false;
+		}
+
+		if(!state.scenario_checksum.is_equal(header.checksum))
+			return false;
+
+		// skip over the mod path, without restoring it into the file system
+		uint32_t mod_path_length = 0;
+		memcpy(&mod_path_length, buffer_pos, sizeof(uint32_t));
+		buffer_pos += sizeof(uint32_t) + mod_path_length * sizeof(native_char);
+
+		buffer_pos = with_decompressed_section(buffer_pos,
+			[&](uint8_t const* ptr_in, uint32_t length) {
+				// DO NOTHING -- this skips over reading the scenario section
+			});
+		buffer_pos = with_decompressed_section(buffer_pos,
+			[&](uint8_t const* ptr_in, uint32_t length) {
+				section_out.assign(ptr_in, ptr_in + length);
+			});
+
+		return true;
+	} else {
+		return false;
+	}
+}
+
 std::string make_time_string(uint64_t value) {
 	std::string result;
 	for(int32_t i = 64 / 4; i --> 0; ) {
@@ -988,6 +1039,145 @@ std::string make_time_string(uint64_t value) {
 	return result;
 }
 
+// The save index is a single file in the save directory listing the metadata of each save file by name.
+// It is only a cache: entries for files that no longer exist are dropped, and files without an entry, or that were
+// written since their entry was made, are read directly, so a missing or damaged index just costs one slow listing.
+
+static native_char const* save_index_file_name = NATIVE("save_index.dat");
+static std::mutex save_index_lock; // saves are written by the game thread, while the ui lists them
+// the index as last read or written, so that it only has to be read from the disk once
+static std::vector<save_index_entry> save_index_entries;
+static bool save_index_loaded = false;
+
+static void load_save_index(simple_fs::directory const& sdir, std::vector<save_index_entry>& entries_out) {
+	auto index_file = simple_fs::open_file(sdir, save_index_file_name);
+	if(!index_file)
+		return;
+	auto contents = simple_fs::view_contents(*index_file);
+	uint8_t const* ptr = reinterpret_cast<uint8_t const*>(contents.data);
+	uint8_t const* end = ptr + contents.file_size;
+
+	uint32_t version = 0;
+	uint32_t count = 0;
+	if(end - ptr < ptrdiff_t(sizeof(uint32_t) * 2))
+		return;
+	ptr = memcpy_deserialize(ptr, version);
+	ptr = memcpy_deserialize(ptr, count);
+	if(version != save_index_version)
+		return;
+
+	entries_out.reserve(count);
+	for(uint32_t i = 0; i < count; ++i) {
+		save_index_entry e;
+		uint32_t name_length = 0;
+		if(end - ptr < ptrdiff_t(sizeof(save_metadata) + sizeof(uint64_t) + sizeof(uint32_t)))
+			break;
+		ptr = memcpy_deserialize(ptr, e.data);
+		ptr = memcpy_deserialize(ptr, e.write_time);
+		ptr = memcpy_deserialize(ptr, name_length);
+		if(size_t(end - ptr) < size_t(name_length) * sizeof(native_char))
+			break;
+		e.file_name.resize(name_length);
+		memcpy(e.file_name.data(), ptr, name_length * sizeof(native_char));
+		ptr += name_length * sizeof(native_char);
+		entries_out.push_back(std::move(e));
+	}
+}
+
+static void store_save_index(simple_fs::directory const& sdir, std::vector<save_index_entry> const& entries) {
+	size_t total_size = sizeof(uint32_t) * 2;
+	for(auto& e : entries)
+		total_size += sizeof(save_metadata) + sizeof(uint64_t) + sizeof(uint32_t) + e.file_name.length() * sizeof(native_char);
+
+	std::vector<uint8_t> buffer(total_size);
+	uint8_t* ptr = buffer.data();
+	ptr = memcpy_serialize(ptr, save_index_version);
+	ptr = memcpy_serialize(ptr, uint32_t(entries.size()));
+	for(auto& e : entries) {
+		ptr = memcpy_serialize(ptr, e.data);
+		ptr = memcpy_serialize(ptr, e.write_time);
+		ptr = memcpy_serialize(ptr, uint32_t(e.file_name.length()));
+		memcpy(ptr, e.file_name.data(), e.file_name.length() * sizeof(native_char));
+		ptr += e.file_name.length() * sizeof(native_char);
+	}
+	simple_fs::write_file(sdir, save_index_file_name, reinterpret_cast<char const*>(buffer.data()), uint32_t(buffer.size()));
+}
+
+// Slow path for save files that are not in the index: reads the header from the file itself (the preview stays empty)
+static bool read_save_metadata_from_file(simple_fs::unopened_file const& f, save_metadata& data_out) {
+	auto of = simple_fs::open_file(f);
+	if(!of)
+		return false;
+	auto content = simple_fs::view_contents(*of);
+	save_header h;
+	if(content.file_size <= sizeof_save_header(h))
+		return false;
+	read_save_header(reinterpret_cast<uint8_t const*>(content.data), h);
+	data_out.timestamp = h.timestamp;
+	data_out.checksum = h.checksum;
+	data_out.tag = h.tag;
+	data_out.cgov = h.cgov;
+	data_out.d = h.d;
+	data_out.compressed_size = uint32_t(content.file_size - sizeof_save_header(h));
+	return true;
+}
+
+static void ensure_save_index_loaded(simple_fs::directory const& sdir) {
+	if(save_index_loaded)
+		return;
+	save_index_entries.clear();
+	load_save_index(sdir, save_index_entries);
+	save_index_loaded = true;
+}
+
+static void add_to_save_index(simple_fs::directory const& sdir, native_string_view name, save_metadata const& data) {
+	std::lock_guard lock{ save_index_lock };
+	ensure_save_index_loaded(sdir);
+	uint64_t write_time = 0;
+	if(auto f = simple_fs::peek_file(sdir, name); f)
+		write_time = simple_fs::get_last_write_time(*f);
+	auto it = std::find_if(save_index_entries.begin(), save_index_entries.end(), [&](save_index_entry const& e) { return e.file_name == name; });
+	if(it != save_index_entries.end()) {
+		it->data = data;
+		it->write_time = write_time;
+	} else {
+		save_index_entries.push_back(save_index_entry{ native_string(name), data, write_time });
+	}
+	store_save_index(sdir, save_index_entries);
+}
+
+std::vector<save_index_entry> read_save_index() {
+	auto sdir = simple_fs::get_or_create_save_game_directory();
+
+	std::lock_guard lock{ save_index_lock };
+	ensure_save_index_loaded(sdir);
+	ankerl::unordered_dense::map<native_string, uint32_t> by_name;
+	for(uint32_t i = 0; i < uint32_t(save_index_entries.size()); ++i)
+		by_name.insert_or_assign(save_index_entries[i].file_name, i);
+
+	std::vector<save_index_entry> result;
+	bool index_changed = false;
+	for(auto& f : simple_fs::list_files(sdir, NATIVE(".bin"))) {
+		auto name = simple_fs::get_file_name(f);
+		auto write_time = simple_fs::get_last_write_time(f);
+		if(auto it = by_name.find(name); it != by_name.end() && save_index_entries[it->second].write_time == write_time) {
+			result.push_back(save_index_entries[it->second]);
+		} else {
+			// not indexed, or replaced since it was
+			save_index_entry e{ name, save_metadata{}, write_time };
+			if(read_save_metadata_from_file(f, e.data)) {
+				result.push_back(std::move(e));
+				index_changed = true;
+			}
+		}
+	}
+	if(index_changed || result.size() != save_index_entries.size()) {
+		save_index_entries = result;
+		store_save_index(sdir, save_index_entries);
+	}
+	return result;
+}
+
 void write_save_file(sys::state& state, bool autosave) {
 	save_header header;
 	header.count = state.scenario_counter;
@@ -1018,16 +1208,33 @@ void write_save_file(sys::state& state, bool autosave) {
 
 	auto sdir = simple_fs::get_or_create_save_game_directory();
 
+	native_string file_name;
 	if(autosave) {
-		simple_fs::write_file(sdir, native_string(NATIVE("autosave_")) + simple_fs::utf8_to_native(std::to_string(state.autosave_counter)) + native_string(NATIVE(".bin")), reinterpret_cast<char*>(temp_buffer), uint32_t(total_size_used));
+		file_name = native_string(NATIVE("autosave_")) + simple_fs::utf8_to_native(std::to_string(state.autosave_counter)) + native_string(NATIVE(".bin"));
 		state.autosave_counter = (state.autosave_counter + 1) % sys::max_autosaves;
 	} else {
 		auto ymd_date = state.current_date.to_ymd(state.start_date);
 		auto base_str = make_time_string(uint64_t(std::time(nullptr))) + "-" + nations::int_to_tag(state.world.national_identity_get_identifying_int(header.tag)) + "-" + std::to_string(ymd_date.year) + "-" + std::to_string(ymd_date.month) + "-" + std::to_string(ymd_date.day) + ".bin";
-		simple_fs::write_file(sdir, simple_fs::utf8_to_native(base_str), reinterpret_cast<char*>(temp_buffer), uint32_t(total_size_used));
+		file_name = simple_fs::utf8_to_native(base_str);
 	}
+	simple_fs::write_file(sdir, file_name, reinterpret_cast<char*>(temp_buffer), uint32_t(total_size_used));
 	delete[] temp_buffer;
 
+	save_metadata data;
+	data.timestamp = header.timestamp;
+	data.checksum = header.checksum;
+	data.tag = header.tag;
+	data.cgov = header.cgov;
+	data.d = header.d;
+	data.compressed_size = uint32_t(total_size_used - sizeof_save_header(header));
+	data.preview.prestige = nations::prestige_score(state, state.local_player_nation);
+	data.preview.industrial_score = state.world.nation_get_industrial_score(state.local_player_nation);
+	data.preview.military_score = state.world.nation_get_military_score(state.local_player_nation);
+	data.preview.treasury = state.world.nation_get_stockpiles(state.local_player_nation, economy::money);
+	data.preview.rank = uint16_t(state.world.nation_get_rank(state.local_player_nation));
+	data.preview.province_count = uint16_t(state.world.nation_get_owned_province_count(state.local_player_nation));
+	add_to_save_index(sdir, file_name, data);
+
 	state.save_list_updated.store(true, std::memory_order::release); // update for ui
 }
 bool try_read_save_file(sys::state& state, native_string_view name) {
@@ -128,7 +128,7 @@ uint8_t const* deserialize(uint8_t const* ptr_in, ankerl::unordered_dense::map<u
 	return ptr_in + sizeof(uint32_t) + sizeof(vec.values()[0]) * length;
 }
 
-constexpr inline uint32_t save_file_version = 35;
+constexpr inline uint32_t save_file_version = 36;
 constexpr inline uint32_t scenario_file_version = 117 + save_file_version;
 
 struct scenario_header {
@@ -148,6 +148,36 @@ struct save_header {
 	sys::date d;
 };
 
+// Small summary of the player's nation at the time of saving, shown without decompressing the save
+struct save_preview {
+	float prestige = 0.0f;
+	float industrial_score = 0.0f;
+	float military_score = 0.0f;
+	float treasury = 0.0f;
+	uint16_t rank = 0;
+	uint16_t province_count = 0;
+};
+
+// Everything the save list needs to know about a save file; kept in the save index so that listing the saves
+// does not require opening each of them
+struct save_metadata {
+	uint64_t timestamp = 0;
+	checksum_key checksum;
+	dcon::national_identity_id tag;
+	dcon::government_type_id cgov;
+	sys::date d;
+	uint32_t compressed_size = 0;
+	save_preview preview;
+};
+
+struct save_index_entry {
+	native_string file_name;
+	save_metadata data;
+	uint64_t write_time = 0; // of the file when the entry was made, the entry is stale if it no longer matches
+};
+
+constexpr inline uint32_t save_index_version = 2;
+
 struct mod_identifier {
 	native_string mod_path;
 	uint64_t timestamp = 0;
@@ -182,8 +212,13 @@ void write_scenario_file(sys::state& state, native_string_view name, uint32_t co
 bool try_read_scenario_file(sys::state& state, native_string_view name);
 bool try_read_scenario_and_save_file(sys::state& state, native_string_view name);
 bool try_read_scenario_as_save_file(sys::state& state, native_string_view name);
+// Copies the uncompressed save section (the start date state) of a scenario file matching the current scenario checksum
+bool try_read_scenario_save_section(sys::state& state, native_string_view name, std::vector<uint8_t>& section_out);
 
 void write_save_file(sys::state& state, bool autosave = false);
 bool try_read_save_file(sys::state& state, native_string_view name);
+// Returns the metadata of every save in the save directory. Entries come from the save index; saves missing from
+// it (copied in by hand, or written by an older version) or replaced since are read once and added to the index
+std::vector<save_index_entry> read_save_index();
 
 } // namespace sys
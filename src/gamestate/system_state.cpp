@@ -461,6 +461,9 @@ inline constexpr int32_t tooltip_width = 400;
 void state::render() { // called to render the frame may (and should) delay returning until the frame is rendered, including
 	// waiting for vsync
 	auto game_state_was_updated = game_state_updated.exchange(false, std::memory_order::acq_rel);
+	if(game_state_was_updated)
+		++map_state.world_version;
+	ui_frame_snapshot = &ui_snapshots.read();
 	auto ownership_update = province_ownership_changed.exchange(false, std::memory_order::acq_rel);
 	if(ownership_update) {
 		if(user_settings.map_label != sys::map_label_mode::none)
@@ -508,6 +511,7 @@ void state::render() { // called to render the frame may (and should) delay retu
 
 		if(ui_state.last_tooltip != tooltip_probe.under_mouse) {
 			ui_state.last_tooltip = tooltip_probe.under_mouse;
+			ui::clear_description_cache(*this);
 			if(tooltip_probe.under_mouse) {
 				auto type = ui_state.last_tooltip->has_tooltip(*this);
 				if(type != ui::tooltip_behavior::no_tooltip) {
@@ -611,6 +615,7 @@ void state::render() { // called to render the frame may (and should) delay retu
 		if(ui_state.tooltip->is_visible()) {
 			ui_state.tooltip->impl_render(*this, ui_state.tooltip->base_data.position.x, ui_state.tooltip->base_data.position.y);
 		}
+		ogl::flush_quad_batch(*this);
 		return;
 	} else if(mode == sys::game_mode_type::pick_nation) {  // NATION PICKER RENDERING
 		ui_state.nation_picker->base_data.size.x = ui_state.root->base_data.size.x;
@@ -656,6 +661,7 @@ void state::render() { // called to render the frame may (and should) delay retu
 
 		if(ui_state.last_tooltip != tooltip_probe.under_mouse) {
 			ui_state.last_tooltip = tooltip_probe.under_mouse;
+			ui::clear_description_cache(*this);
 			if(tooltip_probe.under_mouse) {
 				auto type = ui_state.last_tooltip->has_tooltip(*this);
 				if(type != ui::tooltip_behavior::no_tooltip) {
@@ -753,6 +759,7 @@ void state::render() { // called to render the frame may (and should) delay retu
 			}
 		}
 
+		ogl::flush_quad_batch(*this);
 		map_state.render(*this, x_size, y_size);
 
 		// UI rendering
@@ -778,6 +785,7 @@ void state::render() { // called to render the frame may (and should) delay retu
 		if(ui_state.tooltip->is_visible()) {
 			ui_state.tooltip->impl_render(*this, ui_state.tooltip->base_data.position.x, ui_state.tooltip->base_data.position.y);
 		}
+		ogl::flush_quad_batch(*this);
 		return;
 	} else if(mode == sys::game_mode_type::select_states) {  // SELECT STATES RENDERING
 		ui_state.select_states_legend->base_data.size.x = ui_state.root->base_data.size.x;
@@ -823,6 +831,7 @@ void state::render() { // called to render the frame may (and should) delay retu
 
 		if(ui_state.last_tooltip != tooltip_probe.under_mouse) {
 			ui_state.last_tooltip = tooltip_probe.under_mouse;
+			ui::clear_description_cache(*this);
 			if(tooltip_probe.under_mouse) {
 				auto type = ui_state.last_tooltip->has_tooltip(*this);
 				if(type != ui::tooltip_behavior::no_tooltip) {
@@ -920,6 +929,7 @@ void state::render() { // called to render the frame may (and should) delay retu
 			}
 		}
 
+		ogl::flush_quad_batch(*this);
 		map_state.render(*this, x_size, y_size);
 
 		// UI rendering
@@ -945,6 +955,7 @@ void state::render() { // called to render the frame may (and should) delay retu
 		if(ui_state.tooltip->is_visible()) {
 			ui_state.tooltip->impl_render(*this, ui_state.tooltip->base_data.position.x, ui_state.tooltip->base_data.position.y);
 		}
+		ogl::flush_quad_batch(*this);
 		return;
 	}
 
@@ -1335,6 +1346,7 @@ void state::render() { // called to render the frame may (and should) delay retu
 
 	if(ui_state.last_tooltip != tooltip_probe.under_mouse) {
 		ui_state.last_tooltip = tooltip_probe.under_mouse;
+		ui::clear_description_cache(*this);
 		if(tooltip_probe.under_mouse) {
 			auto type = ui_state.last_tooltip->has_tooltip(*this);
 			if(type != ui::tooltip_behavior::no_tooltip) {
@@ -1482,6 +1494,7 @@ void state::render() { // called to render the frame may (and should) delay retu
 		}
 	}
 
+	ogl::flush_quad_batch(*this);
 	map_state.render(*this, x_size, y_size);
 
 	// UI rendering
@@ -1564,6 +1577,7 @@ void state::render() { // called to render the frame may (and should) delay retu
 	} else {//if there is no tooltip to display, reset tooltip_timer
 		tooltip_timer = std::chrono::steady_clock::now();
 	}
+	ogl::flush_quad_batch(*this);
 }
 void state::on_create() {
 	// Clear "center" property so they don't look messed up!
@@ -3630,6 +3644,9 @@ void state::fill_unsaved_data() { // reconstructs derived values that are not di
 
 	province::update_cached_values(*this);
 	nations::update_cached_values(*this);
+	// this may run on the ui thread, while the snapshots have a single writer: the game loop publishes one for us
+	ui_snapshot_requested.store(true, std::memory_order::release);
+	game_state_updated.store(true, std::memory_order::release); // so that the ui drops anything it derived from the old state
 
 	ai::identify_focuses(*this);
 	ai::initialize_ai_tech_weights(*this);
@@ -3702,6 +3719,26 @@ void state::fill_unsaved_data() { // reconstructs derived values that are not di
 	game_state_updated.store(true, std::memory_order::release);
 }
 
+void state::publish_ui_snapshot() {
+	auto& snapshot = ui_snapshots.write_buffer();
+	snapshot.date = current_date;
+	snapshot.epoch = ++ui_snapshot_epoch;
+	snapshot.ownership_epoch = ownership_epoch;
+	snapshot.player = player_data_cache;
+	snapshot.nations.resize(world.nation_size());
+	for(auto n : world.in_nation) {
+		auto& v = snapshot.nations[n.id.index()];
+		v.prestige = nations::prestige_score(*this, n);
+		v.infamy = n.get_infamy();
+		v.treasury = nations::get_treasury(*this, n);
+		v.population = n.get_demographics(demographics::total);
+		v.literacy = n.get_demographics(demographics::literacy);
+		v.militancy = n.get_demographics(demographics::militancy);
+		v.consciousness = n.get_demographics(demographics::consciousness);
+	}
+	ui_snapshots.publish();
+}
+
 void state::single_game_tick() {
 	// do update logic
 
@@ -3907,6 +3944,9 @@ void state::single_game_tick() {
 	// basic repopulation of demographics derived values
 	demographics::regenerate_from_pop_data_daily(*this);
 
+	// drop the units that have left their provinces since yesterday
+	military::update_unit_presence(*this);
+
 	// values updates pass 1 (mostly trivial things, can be done in parallel)
 	concurrency::parallel_for(0, 17, [&](int32_t index) {
 		switch(index) {
@@ -4003,6 +4043,20 @@ void state::single_game_tick() {
 		ai::update_ai_colonial_investment(*this);
 	}
 
+	// Once per month per-nation ai jobs, each nation on its own day (see ai::update_monthly_schedule)
+	ai::update_monthly_schedule(*this);
+	ai::update_ai_research(*this);
+	ai::build_ships(*this);
+	ai::update_land_constructions(*this);
+	ai::update_ai_econ_construction(*this);
+	ai::update_budget(*this);
+	ai::take_reforms(*this);
+	ai::civilize(*this);
+	ai::make_war_decs(*this);
+	ai::update_cb_fabrication(*this);
+	ai::update_ai_ruling_party(*this);
+	ai::end_monthly_schedule(*this);
+
 	// Once per month updates, spread out over the month
 	switch(ymd_date.day) {
 		case 1:
@@ -4045,7 +4099,6 @@ void state::single_game_tick() {
 			province::update_nationalism(*this);
 			break;
 		case 12:
-			ai::update_ai_research(*this);
 			rebel::update_armies(*this);
 			rebel::rebel_hunting_check(*this);
 			break;
@@ -4061,16 +4114,6 @@ void state::single_game_tick() {
 		case 16:
 			ai::take_ai_decisions(*this);
 			break;
-		case 17:
-			ai::build_ships(*this);
-			ai::update_land_constructions(*this);
-			break;
-		case 18:
-			ai::update_ai_econ_construction(*this);
-			break;
-		case 19:
-			ai::update_budget(*this);
-			break;
 		case 20:
 			nations::monthly_flashpoint_update(*this);
 			ai::make_defense(*this);
@@ -4078,13 +4121,6 @@ void state::single_game_tick() {
 		case 21:
 			ai::update_ai_colony_starting(*this);
 			break;
-		case 22:
-			ai::take_reforms(*this);
-			break;
-		case 23:
-			ai::civilize(*this);
-			ai::make_war_decs(*this);
-			break;
 		case 24:
 			rebel::execute_rebel_victories(*this);
 			ai::make_attacks(*this);
@@ -4111,10 +4147,6 @@ void state::single_game_tick() {
 			rebel::update_armies(*this);
 			rebel::rebel_hunting_check(*this);
 			break;
-		case 31:
-			ai::update_cb_fabrication(*this);
-			ai::update_ai_ruling_party(*this);
-			break;
 		default:
 			break;
 	}
@@ -4122,6 +4154,7 @@ void state::single_game_tick() {
 	military::apply_regiment_damage(*this);
 
 	if(ymd_date.day == 1) {
+		military::validate_relationship_matrix(*this); // does nothing in release builds
 		if(ymd_date.month == 1) {
 			// yearly update : redo the upper house
 			for(auto n : world.in_nation) {
@@ -4207,6 +4240,7 @@ void state::single_game_tick() {
 	}
 
 	ui_date = current_date;
+	publish_ui_snapshot();
 
 	game_state_updated.store(true, std::memory_order::release);
 
@@ -4306,10 +4340,16 @@ void state::game_loop() {
 	game_speed[4] = int32_t(defines.alice_speed_4);
 
 	while(quit_signaled.load(std::memory_order::acquire) == false) {
-		network::send_and_receive_commands(*this);
+		bool network_activity = network::send_and_receive_commands(*this);
 		command::execute_pending_commands(*this);
+		if(ui_snapshot_requested.exchange(false, std::memory_order::acq_rel)) {
+			publish_ui_snapshot();
+			game_state_updated.store(true, std::memory_order::release);
+		}
 		if(network_mode == sys::network_mode_type::client) {
-			std::this_thread::sleep_for(std::chrono::milliseconds(15));
+			// clients advance through the lockstep frames of the host as they arrive
+			if(!network_activity)
+				std::this_thread::sleep_for(std::chrono::milliseconds(15));
 		} else {
 			auto speed = actual_game_speed.load(std::memory_order::acquire);
 			auto upause = ui_pause.load(std::memory_order::acquire);
@@ -4327,11 +4367,8 @@ void state::game_loop() {
 				auto ms_count = std::chrono::duration_cast<std::chrono::milliseconds>(entry_time - last_update).count();
 				if(speed >= 5 || ms_count >= game_speed[speed]) { /*enough time has passed*/
 					last_update = entry_time;
-					if(network_mode == sys::network_mode_type::host) {
-						command::advance_tick(*this, local_player_nation);
-					} else {
-						single_game_tick();
-					}
+					// the host runs its ticks right away, network::send_and_receive_commands batches them into lockstep frames
+					single_game_tick();
 				} else {
 					std::this_thread::sleep_for(std::chrono::milliseconds(1));
 				}
@@ -25,11 +25,13 @@
 #include "province.hpp"
 #include "events.hpp"
 #include "SPSCQueue.h"
+#include "triple_buffer.hpp"
 #include "commands.hpp"
 #include "diplomatic_messages.hpp"
 #include "events.hpp"
 #include "notifications.hpp"
 #include "network.hpp"
+#include "ai.hpp"
 
 // this header will eventually contain the highest-level objects
 // that represent the overall state of the program
@@ -423,6 +425,31 @@ struct player_data { // currently this data is serialized via memcpy, to make su
 	std::array<float, 32> population_record = { 0.0f }; // current day's value = date.value & 31
 };
 
+struct ui_nation_values {
+	float prestige = 0.0f;
+	float infamy = 0.0f;
+	float treasury = 0.0f;
+	float population = 0.0f;
+	float literacy = 0.0f;
+	float militancy = 0.0f;
+	float consciousness = 0.0f;
+};
+
+// values that the ui shows every frame, copied out by the game state whenever it finishes a day or a batch of commands,
+// so that the ui never sees a day half done
+struct ui_snapshot {
+	sys::date date;
+	uint32_t epoch = 0; // different for every snapshot published
+	uint32_t ownership_epoch = 0; // changes only when a province changes owner or a nation changes its name
+	player_data player;
+	std::vector<ui_nation_values> nations;
+
+	ui_nation_values const& nation(dcon::nation_id n) const {
+		static ui_nation_values const none{};
+		return (n && size_t(n.index()) < nations.size()) ? nations[n.index()] : none;
+	}
+};
+
 // the state struct will eventually include (at least pointers to)
 // the state of the sound system, the state of the windowing system,
 // and the game data / state itself
@@ -468,6 +495,7 @@ struct alignas(64) state {
 	std::vector<dcon::nation_id> nations_by_military_score;
 	std::vector<dcon::nation_id> nations_by_prestige_score;
 	std::vector<great_nation> great_nations;
+	ai::monthly_schedule ai_schedule; // the due bits are rebuilt every day; only the month's pairs are saved
 
 	uint64_t scenario_time_stamp = 0;	// for identifying the scenario file
 	uint32_t scenario_counter = 0;		// as above
@@ -563,6 +591,11 @@ struct alignas(64) state {
 	rigtorp::SPSCQueue<command::payload> incoming_commands;          // ui or network -> local gamestate
 	std::atomic<bool> ui_pause = false;                              // force pause by an important message being open
 	std::atomic<bool> railroad_built = true; // game state -> map
+	triple_buffer<ui_snapshot> ui_snapshots;                         // game state -> ui: see publish_ui_snapshot
+	std::atomic<bool> ui_snapshot_requested = false;                 // -> game state: publish a snapshot on the next loop
+	uint32_t ui_snapshot_epoch = 0;                                  // game state side: counts the snapshots published
+	uint32_t ownership_epoch = 0;                                    // game state side: counts owner and name changes
+	ui_snapshot const* ui_frame_snapshot = nullptr;                  // the snapshot the ui is drawing this frame from
 
 	// synchronization: notifications from the gamestate to ui
 	rigtorp::SPSCQueue<event::pending_human_n_event> new_n_event;
@@ -623,6 +656,12 @@ struct alignas(64) state {
 	               // for vsync
 
 	void single_game_tick();
+	void publish_ui_snapshot(); // game state thread only: copies the current values into a new snapshot for the ui
+	ui_snapshot const& ui_view() { // ui side: the snapshot for the current frame
+		if(!ui_frame_snapshot)
+			ui_frame_snapshot = &ui_snapshots.read();
+		return *ui_frame_snapshot;
+	}
 	// this function runs the internal logic of the game. It will return *only* after a quit notification is sent to it
 	void game_loop();
 	sys::checksum_key get_save_checksum();
@@ -152,6 +152,73 @@ void active_modifiers_description(sys::state& state, text::layout_base& layout,
 		dcon::provincial_modifier_value nmid, bool have_header);
 void effect_description(sys::state& state, text::layout_base& layout, dcon::effect_key k, int32_t primary_slot, int32_t this_slot,
 		int32_t from_slot, uint32_t r_lo, uint32_t r_hi);
+
+// When written into the tooltip, trigger descriptions are cached, since variable tooltips are rebuilt every time the game state
+// changes. The text of a trigger description is kept until a province changes owner or a nation its name, but the condition
+// checkmarks in it are evaluated again each time and the text is rebuilt if any of them changed. The cache is emptied whenever
+// the tooltip moves to another element. (Effect descriptions are not cached: the amounts in them change with every tick.)
+void trigger_description(sys::state& state, text::columnar_layout& layout, dcon::trigger_key k, int32_t primary_slot = -1,
+		int32_t this_slot = -1, int32_t from_slot = -1);
+
+struct cached_description_key {
+	int32_t key = 0; // the trigger key
+	int32_t primary_slot = -1;
+	int32_t this_slot = -1;
+	int32_t from_slot = -1;
+
+	bool operator==(cached_description_key const& o) const {
+		return key == o.key && primary_slot == o.primary_slot && this_slot == o.this_slot && from_slot == o.from_slot;
+	}
+};
+
+// where a columnar layout was before or after a description was added to it
+struct cached_layout_position {
+	int32_t used_height = 0;
+	int32_t used_width = 0;
+	int32_t y_cursor = 0;
+	int32_t current_column_x = 0;
+	int32_t column_width = 0;
+	int32_t number_of_lines = 0;
+	text::layout_parameters parameters;
+
+	bool operator==(cached_layout_position const& o) const {
+		return used_height == o.used_height && used_width == o.used_width && y_cursor == o.y_cursor
+			&& current_column_x == o.current_column_x && column_width == o.column_width && number_of_lines == o.number_of_lines
+			&& parameters.left == o.parameters.left && parameters.top == o.parameters.top && parameters.right == o.parameters.right
+			&& parameters.bottom == o.parameters.bottom && parameters.font_id == o.parameters.font_id
+			&& parameters.leading == o.parameters.leading && parameters.align == o.parameters.align
+			&& parameters.color == o.parameters.color && parameters.suppress_hyperlinks == o.parameters.suppress_hyperlinks;
+	}
+};
+
+struct cached_condition {
+	uint16_t const* tval = nullptr;
+	int32_t primary_slot = -1;
+	int32_t this_slot = -1;
+	int32_t from_slot = -1;
+	bool result = false;
+};
+
+struct cached_description {
+	cached_description_key key;
+	uint32_t epoch = 0;
+	cached_layout_position before;
+	cached_layout_position after;
+	std::vector<text::text_chunk> chunks;
+	std::vector<cached_condition> conditions;
+};
+
+struct description_cache {
+	std::vector<cached_description> entries;
+	text::layout const* recording_layout = nullptr; // set while a description is being written into a new entry
+	size_t recording_first_chunk = 0;
+	std::vector<cached_condition> recording_conditions;
+};
+
+void clear_description_cache(sys::state& state);
+// called by the trigger tooltips for each condition checkmark they write
+void record_description_condition(sys::state& state, text::layout_base& layout, uint16_t const* tval, int32_t primary_slot,
+		int32_t this_slot, int32_t from_slot, bool result);
 void invention_description(sys::state& state, text::layout_base& contents, dcon::invention_id inv_id, int32_t indent) noexcept;
 void technology_description(sys::state& state, text::layout_base& contents, dcon::technology_id tech_id) noexcept;
 
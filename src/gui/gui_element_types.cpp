@@ -900,6 +900,7 @@ state::state() {
 	root = std::make_unique<container_base>();
 	tooltip = std::make_unique<tool_tip>();
 	tooltip->flags |= element_base::is_invisible_mask;
+	descriptions = std::make_unique<description_cache>();
 }
 
 state::~state() = default;
@@ -8,6 +8,7 @@
 #include "system_state.hpp"
 #include "text.hpp"
 #include "texture.hpp"
+#include <algorithm>
 #include <cstdint>
 #include <functional>
 #include <unordered_map>
@@ -913,6 +914,78 @@ public:
 	}
 };
 
+// Keeps the contents of a long list box (of dcon ids) sorted across updates. Between two days most rows neither appear nor
+// disappear nor move much, so instead of sorting the whole list again the previous order is kept, and only the rows that
+// fell out of it are sorted and merged back in. The sort key is computed once per row, and only for the column the list is
+// sorted by, rather than again for every comparison
+template<class RowConT>
+class sorted_row_index {
+	struct keyed_row {
+		float key = 0.0f;
+		RowConT row{};
+
+		bool operator<(keyed_row const& o) const {
+			return key < o.key || (key == o.key && row.index() < o.row.index());
+		}
+	};
+
+	std::vector<uint8_t> present;
+	std::vector<keyed_row> in_order;
+	std::vector<keyed_row> out_of_order;
+
+public:
+	// Replaces the rows with the ones collected, keeping the rows that were already there in their current order. New rows go
+	// at the end, until the next call to sort
+	void update_rows(std::vector<RowConT>& rows, std::vector<RowConT> const& collected) {
+		size_t max_index = 0;
+		for(auto r : collected)
+			max_index = std::max(max_index, size_t(r.index()) + 1);
+		present.assign(max_index, uint8_t(0));
+		for(auto r : collected)
+			present[r.index()] = 1;
+
+		size_t kept = 0;
+		for(auto r : rows) {
+			if(size_t(r.index()) < present.size() && present[r.index()] == 1) {
+				present[r.index()] = 2;
+				rows[kept++] = r;
+			}
+		}
+		rows.resize(kept);
+		for(auto r : collected) {
+			if(present[r.index()] == 1) {
+				present[r.index()] = 2;
+				rows.push_back(r);
+			}
+		}
+	}
+
+	// Sorts the rows by key_of(row), smallest first, or largest first if descending. Rows with equal keys are ordered by id
+	template<typename F>
+	void sort(std::vector<RowConT>& rows, F&& key_of, bool descending) {
+		in_order.clear();
+		out_of_order.clear();
+		for(auto r : rows) {
+			keyed_row k{ descending ? -float(key_of(r)) : float(key_of(r)), r };
+			if(in_order.empty() || !(k < in_order.back()))
+				in_order.push_back(k);
+			else
+				out_of_order.push_back(k);
+		}
+		std::sort(out_of_order.begin(), out_of_order.end());
+
+		rows.clear();
+		auto a = in_order.begin();
+		auto b = out_of_order.begin();
+		while(a != in_order.end() || b != out_of_order.end()) {
+			if(b == out_of_order.end() || (a != in_order.end() && !(*b < *a)))
+				rows.push_back((a++)->row);
+			else
+				rows.push_back((b++)->row);
+		}
+	}
+};
+
 class listbox2_scrollbar : public autoscaling_scrollbar {
 public:
 	void on_value_change(sys::state& state, int32_t v) noexcept override;
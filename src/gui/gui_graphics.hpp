@@ -340,6 +340,7 @@ struct element_target {
 
 class tool_tip;
 class grid_box;
+struct description_cache;
 
 template<class T>
 class unit_details_window;
@@ -383,6 +384,7 @@ struct state {
 	std::unique_ptr<element_base> end_screen;
 	std::unique_ptr<element_base> select_states_legend;
 	std::unique_ptr<tool_tip> tooltip;
+	std::unique_ptr<description_cache> descriptions; // trigger and effect descriptions written into the tooltip
 	std::unique_ptr<grid_box> unit_details_box;
 	ankerl::unordered_dense::map<std::string_view, element_target> defs_by_name;
 
@@ -386,6 +386,7 @@ void fonts_mode_checkbox::button_action(sys::state& state) noexcept {
 	state.ui_state.root->impl_on_reset_text(state);
 	state.ui_state.tooltip->set_visible(state, false);
 	state.ui_state.last_tooltip = nullptr;
+	clear_description_cache(state);
 
 	if(state.user_settings.use_classic_fonts) {
 		state.ui_state.tooltip_font = text::name_into_font_id(state, "vic_18_black");
@@ -201,7 +201,7 @@ public:
 			if(state.network_mode == sys::network_mode_type::host) {
 				state.local_player_nation = dcon::nation_id{ };
 				/* Save the buffer before we fill the unsaved data */
-				state.network_state.current_save_length = network::write_network_save(state, state.network_state.current_save_buffer);
+				network::write_network_save(state);
 				state.fill_unsaved_data();
 				for(const auto n : players)
 					state.world.nation_set_is_player_controlled(n, true);
@@ -214,7 +214,7 @@ public:
 				c.type = command::command_type::notify_save_loaded;
 				c.source = state.local_player_nation;
 				c.data.notify_save_loaded.target = dcon::nation_id{};
-				network::broadcast_save_to_clients(state, c, state.network_state.current_save_buffer.get(), state.network_state.current_save_length);
+				network::broadcast_save_to_clients(state, c);
 			} else {
 				state.fill_unsaved_data();
 			}
@@ -354,17 +354,9 @@ protected:
 		row_contents.clear();
 		row_contents.push_back(save_item{ NATIVE(""), 0, dcon::national_identity_id{ }, sys::date(0), dcon::government_type_id{ }, true });
 
-		auto sdir = simple_fs::get_or_create_save_game_directory();
-		for(auto& f : simple_fs::list_files(sdir, NATIVE(".bin"))) {
-			auto of = simple_fs::open_file(f);
-			if(of) {
-				auto content = simple_fs::view_contents(*of);
-				sys::save_header h;
-				if(content.file_size > sys::sizeof_save_header(h))
-					sys::read_save_header(reinterpret_cast<uint8_t const*>(content.data), h);
-				if(h.checksum.is_equal(state.scenario_checksum)) {
-					row_contents.push_back(save_item{ simple_fs::get_file_name(f), h.timestamp, h.tag, h.d, h.cgov, false });
-				}
+		for(auto& e : sys::read_save_index()) {
+			if(e.data.checksum.is_equal(state.scenario_checksum)) {
+				row_contents.push_back(save_item{ e.file_name, e.data.timestamp, e.data.tag, e.data.d, e.data.cgov, false });
 			}
 		}
 
@@ -594,7 +586,7 @@ public:
 			bool old_disabled = disabled;
 			for(auto const& client : state.network_state.clients) {
 				if(client.is_active()) {
-					disabled = disabled || !client.send_buffer.empty();
+					disabled = disabled || client.has_pending_send();
 				}
 			}
 			button_element_base::render(state, x, y);
@@ -625,7 +617,7 @@ public:
 			}
 			for(auto const& client : state.network_state.clients) {
 				if(client.is_active()) {
-					if(!client.send_buffer.empty()) {
+					if(client.has_pending_send()) {
 						text::substitution_map sub;
 						text::add_to_substitution_map(sub, text::variable_type::playername, client.playing_as);
 						text::localised_format_box(state, contents, box, std::string_view("alice_play_pending_client"), sub);
@@ -38,7 +38,7 @@ public:
 class topbar_nation_prestige_text : public simple_text_element_base {
 public:
 	void on_update(sys::state& state) noexcept override {
-		set_text(state, std::to_string(int32_t(nations::prestige_score(state, retrieve<dcon::nation_id>(state, parent)))));
+		set_text(state, std::to_string(int32_t(state.ui_view().nation(retrieve<dcon::nation_id>(state, parent)).prestige)));
 	}
 	tooltip_behavior has_tooltip(sys::state& state) noexcept override {
 		return tooltip_behavior::variable_tooltip;
@@ -169,12 +169,13 @@ public:
 	}
 
 	void on_update(sys::state& state) noexcept override {
+		auto& snapshot = state.ui_view();
 		std::vector<float> datapoints(size_t(32));
-		for(size_t i = 0; i < state.player_data_cache.treasury_record.size(); ++i)
-			datapoints[i] = state.player_data_cache.treasury_record[(state.ui_date.value + 1 + i) % 32] -
-				state.player_data_cache.treasury_record[(state.ui_date.value + 0 + i) % 32];
-		datapoints[datapoints.size() - 1] = state.player_data_cache.treasury_record[(state.ui_date.value + 1 + 31) % 32] -
-																				state.player_data_cache.treasury_record[(state.ui_date.value + 0 + 31) % 32];
+		for(size_t i = 0; i < snapshot.player.treasury_record.size(); ++i)
+			datapoints[i] = snapshot.player.treasury_record[(snapshot.date.value + 1 + i) % 32] -
+				snapshot.player.treasury_record[(snapshot.date.value + 0 + i) % 32];
+		datapoints[datapoints.size() - 1] = snapshot.player.treasury_record[(snapshot.date.value + 1 + 31) % 32] -
+																				snapshot.player.treasury_record[(snapshot.date.value + 0 + 31) % 32];
 		datapoints[0] = datapoints[1]; // otherwise you will store the difference between two non-consecutive days here
 
 		set_data_points(state, datapoints);
@@ -190,9 +191,9 @@ public:
 	}
 
 	void on_update(sys::state& state) noexcept override {
-		auto n = retrieve<dcon::nation_id>(state, parent);
-		auto literacy = state.world.nation_get_demographics(n, demographics::literacy);
-		auto total_pop = std::max(1.0f, state.world.nation_get_demographics(n, demographics::total));
+		auto& values = state.ui_view().nation(retrieve<dcon::nation_id>(state, parent));
+		auto literacy = values.literacy;
+		auto total_pop = std::max(1.0f, values.population);
 		set_text(state, text::format_percentage(literacy / total_pop, 1));
 	}
 
@@ -225,7 +226,7 @@ public:
 		expanded_hitbox_text::on_create(state);
 	}
 	void on_update(sys::state& state) noexcept override {
-		set_text(state, text::format_float(state.world.nation_get_infamy(retrieve<dcon::nation_id>(state, parent)), 2));
+		set_text(state, text::format_float(state.ui_view().nation(retrieve<dcon::nation_id>(state, parent)).infamy, 2));
 	}
 	tooltip_behavior has_tooltip(sys::state& state) noexcept override {
 		return tooltip_behavior::variable_tooltip;
@@ -254,13 +255,13 @@ public:
 class topbar_nation_population_text : public multiline_text_element_base {
 public:
 	void on_update(sys::state& state) noexcept override {
-		auto n = retrieve<dcon::nation_id>(state, parent);
-		auto total_pop = state.world.nation_get_demographics(n, demographics::total);
+		auto& snapshot = state.ui_view();
+		auto total_pop = snapshot.nation(retrieve<dcon::nation_id>(state, parent)).population;
 
-		auto pop_amount = state.player_data_cache.population_record[state.ui_date.value % 32];
-		auto pop_change = state.ui_date.value <= 32
-			? (state.ui_date.value <= 2 ? 0.0f : pop_amount - state.player_data_cache.population_record[2])
-			: (pop_amount - state.player_data_cache.population_record[(state.ui_date.value - 30) % 32]);
+		auto pop_amount = snapshot.player.population_record[snapshot.date.value % 32];
+		auto pop_change = snapshot.date.value <= 32
+			? (snapshot.date.value <= 2 ? 0.0f : pop_amount - snapshot.player.population_record[2])
+			: (pop_amount - snapshot.player.population_record[(snapshot.date.value - 30) % 32]);
 
 		text::text_color color = pop_change < 0 ?  text::text_color::red : text::text_color::green;
 		if(pop_change == 0)
@@ -309,17 +310,17 @@ public:
 class topbar_treasury_text : public multiline_text_element_base {
 public:
 	void on_update(sys::state& state) noexcept override {
-		auto n = retrieve<dcon::nation_id>(state, parent);
+		auto& snapshot = state.ui_view();
 
 		auto layout = text::create_endless_layout(internal_layout,
 		text::layout_parameters{ 0, 0, int16_t(base_data.size.x), int16_t(base_data.size.y), base_data.data.text.font_handle, 0, text::alignment::center, text::text_color::black, false });
 		auto box = text::open_layout_box(layout, 0);
 
-		auto current_day_record = state.player_data_cache.treasury_record[state.ui_date.value % 32];
-		auto previous_day_record = state.player_data_cache.treasury_record[(state.ui_date.value + 31) % 32];
+		auto current_day_record = snapshot.player.treasury_record[snapshot.date.value % 32];
+		auto previous_day_record = snapshot.player.treasury_record[(snapshot.date.value + 31) % 32];
 		auto change = current_day_record - previous_day_record;
 
-		text::add_to_layout_box(state, layout, box, text::prettify_currency(nations::get_treasury(state, n)));
+		text::add_to_layout_box(state, layout, box, text::prettify_currency(snapshot.nation(retrieve<dcon::nation_id>(state, parent)).treasury));
 		text::add_to_layout_box(state, layout, box, std::string(" ("));
 		if(change > 0) {
 			text::add_to_layout_box(state, layout, box, std::string("+"), text::text_color::green);
@@ -483,10 +484,8 @@ public:
 	}
 
 	void on_update(sys::state& state) noexcept override {
-		auto nation_id = retrieve<dcon::nation_id>(state, parent);
-		auto militancy = state.world.nation_get_demographics(nation_id, demographics::militancy);
-		auto total_pop = state.world.nation_get_demographics(nation_id, demographics::total);
-		set_text(state, text::format_float(militancy / total_pop));
+		auto& values = state.ui_view().nation(retrieve<dcon::nation_id>(state, parent));
+		set_text(state, text::format_float(values.militancy / values.population));
 	}
 
 	tooltip_behavior has_tooltip(sys::state& state) noexcept override {
@@ -527,10 +526,8 @@ public:
 	}
 
 	void on_update(sys::state& state) noexcept override {
-		auto nation_id = retrieve<dcon::nation_id>(state, parent);
-		auto militancy = state.world.nation_get_demographics(nation_id, demographics::consciousness);
-		auto total_pop = state.world.nation_get_demographics(nation_id, demographics::total);
-		set_text(state, text::format_float(militancy / total_pop));
+		auto& values = state.ui_view().nation(retrieve<dcon::nation_id>(state, parent));
+		set_text(state, text::format_float(values.consciousness / values.population));
 	}
 
 	void update_tooltip(sys::state& state, int32_t x, int32_t y, text::columnar_layout& contents) noexcept override {
@@ -819,7 +816,7 @@ public:
 class topbar_date_text : public simple_text_element_base {
 public:
 	void on_update(sys::state& state) noexcept override {
-		set_text(state, text::date_to_string(state, state.current_date));
+		set_text(state, text::date_to_string(state, state.ui_view().date));
 	}
 };
 
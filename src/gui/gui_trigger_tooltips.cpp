@@ -126,9 +126,11 @@ void make_condition(TRIGGER_DISPLAY_PARAMS, text::layout_box& box) {
 		
 			if(trigger::evaluate(ws, tval, primary_slot, this_slot, from_slot)) {
 				text::add_to_layout_box(ws, layout, box, std::string_view("\x02"), text::text_color::green);
+				record_description_condition(ws, layout, tval, primary_slot, this_slot, from_slot, true);
 				text::add_space_to_layout_box(ws, layout, box);
 			} else {
 				text::add_to_layout_box(ws, layout, box, std::string_view("\x01"), text::text_color::red);
+				record_description_condition(ws, layout, tval, primary_slot, this_slot, from_slot, false);
 				text::add_space_to_layout_box(ws, layout, box);
 			}
 		
@@ -8437,6 +8439,109 @@ void trigger_description(sys::state& state, text::layout_base& layout, dcon::tri
 			primary_slot, this_slot, from_slot, 0, true);
 }
 
+inline constexpr size_t max_cached_descriptions = 32;
+
+void clear_description_cache(sys::state& state) {
+	state.ui_state.descriptions->entries.clear();
+}
+
+void record_description_condition(sys::state& state, text::layout_base& layout, uint16_t const* tval, int32_t primary_slot,
+		int32_t this_slot, int32_t from_slot, bool result) {
+	auto& cache = *state.ui_state.descriptions;
+	if(cache.recording_layout == &layout.base_layout)
+		cache.recording_conditions.push_back(cached_condition{ tval, primary_slot, this_slot, from_slot, result });
+}
+
+cached_layout_position get_cached_layout_position(text::columnar_layout const& layout) {
+	return cached_layout_position{ layout.used_height, layout.used_width, layout.y_cursor, layout.current_column_x,
+		layout.column_width, layout.base_layout.number_of_lines, layout.fixed_parameters };
+}
+
+// only the tooltip is cached, which also keeps the cache on the ui thread
+bool is_cached_description_layout(sys::state& state, text::columnar_layout const& layout) {
+	return state.ui_state.tooltip && &layout.base_layout == &state.ui_state.tooltip->internal_layout
+		&& !state.ui_state.descriptions->recording_layout;
+}
+
+// Writes a description into the tooltip, from the cache if there is an entry for the same key and epoch, made at the same position
+// in the layout, whose conditions all still evaluate the same; with make_description otherwise
+template<typename F>
+void write_cached_description(sys::state& state, text::columnar_layout& layout, cached_description_key const& key, uint32_t epoch,
+		F&& make_description) {
+	auto& cache = *state.ui_state.descriptions;
+	auto before = get_cached_layout_position(layout);
+	for(auto& e : cache.entries) {
+		if(e.key == key && e.epoch == epoch && e.before == before) {
+			bool unchanged = true;
+			for(auto const& c : e.conditions) {
+				if(trigger::evaluate(state, c.tval, c.primary_slot, c.this_slot, c.from_slot) != c.result) {
+					unchanged = false;
+					break;
+				}
+			}
+			if(!unchanged)
+				break;
+
+			layout.base_layout.contents.insert(layout.base_layout.contents.end(), e.chunks.begin(), e.chunks.end());
+			layout.base_layout.number_of_lines = e.after.number_of_lines;
+			layout.used_height = e.after.used_height;
+			layout.used_width = e.after.used_width;
+			layout.y_cursor = e.after.y_cursor;
+			layout.current_column_x = e.after.current_column_x;
+			layout.column_width = e.after.column_width;
+			return;
+		}
+	}
+
+	cache.recording_layout = &layout.base_layout;
+	cache.recording_first_chunk = layout.base_layout.contents.size();
+	cache.recording_conditions.clear();
+	make_description();
+	cache.recording_layout = nullptr;
+
+	cached_description* entry = nullptr;
+	for(auto& e : cache.entries) {
+		if(e.key == key) {
+			entry = &e;
+			break;
+		}
+	}
+	if(!entry) {
+		if(cache.entries.size() >= max_cached_descriptions)
+			cache.entries.clear();
+		entry = &cache.entries.emplace_back();
+	}
+	entry->key = key;
+	entry->epoch = epoch;
+	entry->before = before;
+	entry->after = get_cached_layout_position(layout);
+	entry->chunks.assign(layout.base_layout.contents.begin() + cache.recording_first_chunk, layout.base_layout.contents.end());
+	entry->conditions.swap(cache.recording_conditions);
+}
+
+// The text of a trigger description names the nations and provinces its scopes lead to, which change with owners and names; the
+// values it compares against live in the condition checkmarks, which are evaluated again on every rebuild. Other scopes (a
+// controller, a capital) are caught up with when the tooltip is opened again
+uint32_t trigger_description_epoch(sys::state& state) {
+	return state.ui_view().ownership_epoch;
+}
+
+void trigger_description(sys::state& state, text::columnar_layout& layout, dcon::trigger_key k, int32_t primary_slot,
+		int32_t this_slot, int32_t from_slot) {
+	if(!k)
+		return;
+	if(!is_cached_description_layout(state, layout)) {
+		trigger_description(state, static_cast<text::layout_base&>(layout), k, primary_slot, this_slot, from_slot);
+		return;
+	}
+
+	write_cached_description(state, layout, cached_description_key{ int32_t(k.index()), primary_slot, this_slot, from_slot },
+			trigger_description_epoch(state), [&]() {
+		trigger_tooltip::make_trigger_description(state, layout, state.trigger_data.data() + state.trigger_data_indices[k.index() + 1],
+				primary_slot, this_slot, from_slot, 0, true);
+	});
+}
+
 void multiplicative_value_modifier_description(sys::state& state, text::layout_base& layout, dcon::value_modifier_key modifier,
 		int32_t primary_slot, int32_t this_slot, int32_t from_slot) {
 	auto base = state.value_modifiers[modifier];
@@ -2939,8 +2939,16 @@ private:
 	pop_list_sort sort = pop_list_sort::size;
 	bool sort_ascend = true;
 
+	// The pop list is only collected and sorted again when a new day was simulated or when what it shows was changed
+	sorted_row_index<dcon::pop_id> pop_sort_index;
+	std::vector<dcon::pop_id> collected_pops;
+	sys::date pop_list_date{};
+	dcon::nation_id pop_list_nation{};
+	bool pop_list_dirty = true;
+	bool pop_list_sort_dirty = true;
+
 	void update_pop_list(sys::state& state) {
-		country_pop_listbox->row_contents.clear();
+		collected_pops.clear();
 
 		auto nation_id = std::holds_alternative<dcon::nation_id>(filter) ? std::get<dcon::nation_id>(filter) : state.local_player_nation;
 		std::vector<dcon::state_instance_id> state_list{};
@@ -2964,136 +2972,68 @@ private:
 				auto pop_id = state.world.pop_location_get_pop(id);
 				auto pt_id = state.world.pop_get_poptype(pop_id);
 				if(pop_filters[dcon::pop_type_id::value_base_t(pt_id.id.index())])
-					country_pop_listbox->row_contents.push_back(pop_id);
+					collected_pops.push_back(pop_id);
 			});
 		}
+		pop_sort_index.update_rows(country_pop_listbox->row_contents, collected_pops);
 	}
 
 	void sort_pop_list(sys::state& state) {
-		std::function<bool(dcon::pop_id, dcon::pop_id)> fn;
+		// keys are arranged so that the smallest one goes first when sorting in ascending order
+		auto& rows = country_pop_listbox->row_contents;
+		bool descending = !sort_ascend;
 		switch(sort) {
 		case pop_list_sort::type:
-			fn = [&](dcon::pop_id a, dcon::pop_id b) {
-				auto a_fat_id = dcon::fatten(state.world, a);
-				auto b_fat_id = dcon::fatten(state.world, b);
-				return a_fat_id.get_poptype().id.index() < b_fat_id.get_poptype().id.index();
-			};
+			pop_sort_index.sort(rows, [&](dcon::pop_id p) { return float(state.world.pop_get_poptype(p).index()); }, descending);
 			break;
 		case pop_list_sort::size:
-			fn = [&](dcon::pop_id a, dcon::pop_id b) {
-				auto a_fat_id = dcon::fatten(state.world, a);
-				auto b_fat_id = dcon::fatten(state.world, b);
-				return a_fat_id.get_size() > b_fat_id.get_size();
-			};
+			pop_sort_index.sort(rows, [&](dcon::pop_id p) { return -state.world.pop_get_size(p); }, descending);
 			break;
 		case pop_list_sort::con:
-			fn = [&](dcon::pop_id a, dcon::pop_id b) {
-				auto a_fat_id = dcon::fatten(state.world, a);
-				auto b_fat_id = dcon::fatten(state.world, b);
-				return a_fat_id.get_consciousness() > b_fat_id.get_consciousness();
-			};
+			pop_sort_index.sort(rows, [&](dcon::pop_id p) { return -state.world.pop_get_consciousness(p); }, descending);
 			break;
 		case pop_list_sort::mil:
-			fn = [&](dcon::pop_id a, dcon::pop_id b) {
-				auto a_fat_id = dcon::fatten(state.world, a);
-				auto b_fat_id = dcon::fatten(state.world, b);
-				return a_fat_id.get_militancy() > b_fat_id.get_militancy();
-			};
+			pop_sort_index.sort(rows, [&](dcon::pop_id p) { return -state.world.pop_get_militancy(p); }, descending);
 			break;
 		case pop_list_sort::religion:
-			fn = [&](dcon::pop_id a, dcon::pop_id b) {
-				auto a_fat_id = dcon::fatten(state.world, a);
-				auto b_fat_id = dcon::fatten(state.world, b);
-				return a_fat_id.get_religion().id.index() < b_fat_id.get_religion().id.index();
-			};
+			pop_sort_index.sort(rows, [&](dcon::pop_id p) { return float(state.world.pop_get_religion(p).index()); }, descending);
 			break;
 		case pop_list_sort::nationality:
-			fn = [&](dcon::pop_id a, dcon::pop_id b) {
-				auto a_fat_id = dcon::fatten(state.world, a);
-				auto b_fat_id = dcon::fatten(state.world, b);
-				return a_fat_id.get_culture().id.index() < b_fat_id.get_culture().id.index();
-			};
+			pop_sort_index.sort(rows, [&](dcon::pop_id p) { return float(state.world.pop_get_culture(p).index()); }, descending);
 			break;
 		case pop_list_sort::location:
-			fn = [&](dcon::pop_id a, dcon::pop_id b) {
-				auto a_fat_id = dcon::fatten(state.world, a);
-				auto b_fat_id = dcon::fatten(state.world, b);
-				return a_fat_id.get_pop_location_as_pop().id.index() < b_fat_id.get_pop_location_as_pop().id.index();
-			};
+			pop_sort_index.sort(rows, [&](dcon::pop_id p) { return float(state.world.pop_get_pop_location_as_pop(p).index()); }, descending);
 			break;
 		case pop_list_sort::cash:
-			fn = [&](dcon::pop_id a, dcon::pop_id b) {
-				auto a_fat_id = dcon::fatten(state.world, a);
-				auto b_fat_id = dcon::fatten(state.world, b);
-				return a_fat_id.get_savings() > b_fat_id.get_savings();
-			};
+			pop_sort_index.sort(rows, [&](dcon::pop_id p) { return -state.world.pop_get_savings(p); }, descending);
 			break;
 		case pop_list_sort::unemployment:
-			fn = [&](dcon::pop_id a, dcon::pop_id b) {
-				auto a_fat_id = dcon::fatten(state.world, a);
-				auto b_fat_id = dcon::fatten(state.world, b);
-				return a_fat_id.get_employment() < b_fat_id.get_employment();
-			};
+			pop_sort_index.sort(rows, [&](dcon::pop_id p) { return state.world.pop_get_employment(p); }, descending);
 			break;
 		case pop_list_sort::ideology:
-			fn = [&](dcon::pop_id a, dcon::pop_id b) {
-				auto a_fat_id = dcon::fatten(state.world, a);
-				auto b_fat_id = dcon::fatten(state.world, b);
-				return a_fat_id.get_dominant_ideology().id.index() < b_fat_id.get_dominant_ideology().id.index();
-			};
+			pop_sort_index.sort(rows, [&](dcon::pop_id p) { return float(state.world.pop_get_dominant_ideology(p).index()); }, descending);
 			break;
 		case pop_list_sort::issues:
-			fn = [&](dcon::pop_id a, dcon::pop_id b) {
-				auto a_fat_id = dcon::fatten(state.world, a);
-				auto b_fat_id = dcon::fatten(state.world, b);
-				return a_fat_id.get_dominant_issue_option().id.index() < b_fat_id.get_dominant_issue_option().id.index();
-			};
+			pop_sort_index.sort(rows, [&](dcon::pop_id p) { return float(state.world.pop_get_dominant_issue_option(p).index()); }, descending);
 			break;
 		case pop_list_sort::life_needs:
-			fn = [&](dcon::pop_id a, dcon::pop_id b) {
-				auto a_fat_id = dcon::fatten(state.world, a);
-				auto b_fat_id = dcon::fatten(state.world, b);
-				return a_fat_id.get_life_needs_satisfaction() > b_fat_id.get_life_needs_satisfaction();
-			};
+			pop_sort_index.sort(rows, [&](dcon::pop_id p) { return -state.world.pop_get_life_needs_satisfaction(p); }, descending);
 			break;
 		case pop_list_sort::everyday_needs:
-			fn = [&](dcon::pop_id a, dcon::pop_id b) {
-				auto a_fat_id = dcon::fatten(state.world, a);
-				auto b_fat_id = dcon::fatten(state.world, b);
-				return a_fat_id.get_everyday_needs_satisfaction() > b_fat_id.get_everyday_needs_satisfaction();
-			};
+			pop_sort_index.sort(rows, [&](dcon::pop_id p) { return -state.world.pop_get_everyday_needs_satisfaction(p); }, descending);
 			break;
 		case pop_list_sort::luxury_needs:
-			fn = [&](dcon::pop_id a, dcon::pop_id b) {
-				auto a_fat_id = dcon::fatten(state.world, a);
-				auto b_fat_id = dcon::fatten(state.world, b);
-				return a_fat_id.get_luxury_needs_satisfaction() > b_fat_id.get_luxury_needs_satisfaction();
-			};
+			pop_sort_index.sort(rows, [&](dcon::pop_id p) { return -state.world.pop_get_luxury_needs_satisfaction(p); }, descending);
 			break;
 		case pop_list_sort::literacy:
-			fn = [&](dcon::pop_id a, dcon::pop_id b) {
-				auto a_fat_id = dcon::fatten(state.world, a);
-				auto b_fat_id = dcon::fatten(state.world, b);
-				return a_fat_id.get_literacy() > b_fat_id.get_literacy();
-			};
+			pop_sort_index.sort(rows, [&](dcon::pop_id p) { return -state.world.pop_get_literacy(p); }, descending);
 			break;
 		// TODO: Implement revoltrisk and growth sorts
 		case pop_list_sort::revoltrisk:
 		case pop_list_sort::change:
-			fn = [&](dcon::pop_id a, dcon::pop_id b) {
-				auto a_fat_id = dcon::fatten(state.world, a);
-				auto b_fat_id = dcon::fatten(state.world, b);
-				return a_fat_id.id.index() < b_fat_id.id.index();
-			};
+			pop_sort_index.sort(rows, [&](dcon::pop_id p) { return float(p.index()); }, descending);
 			break;
 		}
-		std::stable_sort(country_pop_listbox->row_contents.begin(), country_pop_listbox->row_contents.end(),
-				[&](dcon::pop_id a, dcon::pop_id b) {
-					return fn(a, b);
-				});
-		if(!sort_ascend) {
-			std::reverse(country_pop_listbox->row_contents.begin(), country_pop_listbox->row_contents.end());
-		}
 	}
 
 	void populate_left_side_list(sys::state& state) {
@@ -3313,8 +3253,18 @@ public:
 
 	void on_update(sys::state& state) noexcept override {
 		if(country_pop_listbox) {
-			update_pop_list(state);
-			sort_pop_list(state);
+			auto nation_id = std::holds_alternative<dcon::nation_id>(filter) ? std::get<dcon::nation_id>(filter) : state.local_player_nation;
+			if(pop_list_dirty || pop_list_date != state.current_date || pop_list_nation != nation_id) {
+				update_pop_list(state);
+				pop_list_date = state.current_date;
+				pop_list_nation = nation_id;
+				pop_list_dirty = false;
+				pop_list_sort_dirty = true;
+			}
+			if(pop_list_sort_dirty) {
+				sort_pop_list(state);
+				pop_list_sort_dirty = false;
+			}
 			country_pop_listbox->update(state);
 		}
 		if(left_side_listbox) {
@@ -3328,6 +3278,7 @@ public:
 	message_result set(sys::state& state, Cyto::Any& payload) noexcept override {
 		if(payload.holds_type<pop_list_filter>()) {
 			filter = any_cast<pop_list_filter>(payload);
+			pop_list_dirty = true;
 			impl_on_update(state);
 			return message_result::consumed;
 		} else if(payload.holds_type<pop_details_data>()) {
@@ -3346,18 +3297,21 @@ public:
 			auto data = any_cast<pop_filter_data>(payload);
 			auto ptid = std::get<dcon::pop_type_id>(data);
 			pop_filters[dcon::pop_type_id::value_base_t(ptid.index())] = !pop_filters[dcon::pop_type_id::value_base_t(ptid.index())];
+			pop_list_dirty = true;
 			impl_on_update(state);
 			return message_result::consumed;
 		} else if(payload.holds_type<pop_filter_select_action>()) {
 			auto data = any_cast<pop_filter_select_action>(payload);
 			state.world.for_each_pop_type(
 					[&](dcon::pop_type_id id) { pop_filters[dcon::pop_type_id::value_base_t(id.index())] = data.value; });
+			pop_list_dirty = true;
 			impl_on_update(state);
 			return message_result::consumed;
 		} else if(payload.holds_type<pop_list_sort>()) {
 			auto new_sort = any_cast<pop_list_sort>(payload);
 			sort_ascend = (new_sort == sort) ? !sort_ascend : true;
 			sort = new_sort;
+			pop_list_sort_dirty = true;
 			impl_on_update(state);
 			return message_result::consumed;
 		}
@@ -106,25 +106,24 @@ void add_nation_visible_provinces(sys::state& state, std::vector<dcon::province_
 }
 
 void display_data::update_fog_of_war(sys::state& state) {
-	std::vector<dcon::province_id> direct_provinces;
-	add_nation_visible_provinces(state, direct_provinces, state.local_player_nation);
+	fow_direct_provinces.clear();
+	add_nation_visible_provinces(state, fow_direct_provinces, state.local_player_nation);
 	for(auto urel : state.world.nation_get_overlord_as_ruler(state.local_player_nation))
-		add_nation_visible_provinces(state, direct_provinces, urel.get_subject());
+		add_nation_visible_provinces(state, fow_direct_provinces, urel.get_subject());
 	for(auto rel : state.world.nation_get_diplomatic_relation(state.local_player_nation)) {
 		if(rel.get_are_allied()) {
 			auto n = rel.get_related_nations(0) == state.local_player_nation ? rel.get_related_nations(1) : rel.get_related_nations(0);
-			add_nation_visible_provinces(state, direct_provinces, n);
+			add_nation_visible_provinces(state, fow_direct_provinces, n);
 			for(auto urel : state.world.nation_get_overlord_as_ruler(n))
-				add_nation_visible_provinces(state, direct_provinces, urel.get_subject());
+				add_nation_visible_provinces(state, fow_direct_provinces, urel.get_subject());
 		}
 	}
 
-	// update fog of war too
-	std::vector<uint32_t> province_fows(state.world.province_size() + 1, 0xFFFFFFFF);
-	if(state.user_settings.fow_enabled || state.network_mode != sys::network_mode_type::single_player) {
-		state.map_state.visible_provinces.clear();
-		state.map_state.visible_provinces.resize(state.world.province_size() + 1, false);
-		for(auto p : direct_provinces) {
+	uint32_t size = state.world.province_size() + 1;
+	bool fow_enabled = state.user_settings.fow_enabled || state.network_mode != sys::network_mode_type::single_player;
+	state.map_state.visible_provinces.assign(size, !fow_enabled);
+	if(fow_enabled) {
+		for(auto p : fow_direct_provinces) {
 			if(bool(p)) {
 				state.map_state.visible_provinces[province::to_map_id(p)] = true;
 				for(auto c : state.world.province_get_province_adjacency(p)) {
@@ -135,13 +134,39 @@ void display_data::update_fog_of_war(sys::state& state) {
 				}
 			}
 		}
-		for(auto p : state.world.in_province)
-			province_fows[province::to_map_id(p)] = uint32_t(state.map_state.visible_provinces[province::to_map_id(p)] ? 0xFFFFFFFF : 0x7B7B7B7B);
-		gen_prov_color_texture(textures[texture_province_fow], province_fows);
-	} else {
-		state.map_state.visible_provinces.clear();
-		state.map_state.visible_provinces.resize(state.world.province_size() + 1, true);
+	}
+
+	// the fog of war texture keeps what it was last given, so only the rows with provinces that changed are uploaded
+	bool full_upload = province_fows.size() != size;
+	if(full_upload)
+		province_fows.assign(size, 0xFFFFFFFF);
+	uint32_t first_changed = size;
+	uint32_t last_changed = 0;
+	for(auto p : state.world.in_province) {
+		auto id = uint32_t(province::to_map_id(p));
+		auto color = uint32_t(state.map_state.visible_provinces[id] ? 0xFFFFFFFF : 0x7B7B7B7B);
+		if(province_fows[id] != color) {
+			province_fows[id] = color;
+			first_changed = std::min(first_changed, id);
+			last_changed = std::max(last_changed, id);
+		}
+	}
+
+	if(full_upload) {
 		gen_prov_color_texture(textures[texture_province_fow], province_fows);
+	} else if(first_changed <= last_changed) {
+		uint32_t full_rows = size / 256;
+		uint32_t first_row = first_changed / 256;
+		uint32_t last_row = last_changed / 256;
+
+		glBindTexture(GL_TEXTURE_2D, textures[texture_province_fow]);
+		if(first_row < full_rows) {
+			auto end_row = std::min(last_row + 1, full_rows);
+			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, first_row, 256, end_row - first_row, GL_RGBA, GL_UNSIGNED_BYTE, &province_fows[first_row * 256]);
+		}
+		if(last_row == full_rows) // the partly filled row at the end
+			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, full_rows, size % 256, 1, GL_RGBA, GL_UNSIGNED_BYTE, &province_fows[full_rows * 256]);
+		glBindTexture(GL_TEXTURE_2D, 0);
 	}
 }
 
@@ -734,7 +759,33 @@ void display_data::set_selected_province(sys::state& state, dcon::province_id pr
 }
 
 void display_data::set_province_color(std::vector<uint32_t> const& prov_color) {
-	gen_prov_color_texture(texture_arrays[texture_array_province_color], prov_color, 2);
+	if(province_colors.size() != prov_color.size()) {
+		province_colors = prov_color;
+		gen_prov_color_texture(texture_arrays[texture_array_province_color], prov_color, 2);
+		return;
+	}
+
+	// otherwise only the rows of each layer that hold a changed province are sent
+	uint32_t layer_size = uint32_t(prov_color.size() / 2);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, texture_arrays[texture_array_province_color]);
+	for(uint32_t layer = 0; layer < 2; ++layer) {
+		uint32_t base = layer * layer_size;
+		uint32_t first = layer_size;
+		uint32_t last = 0;
+		for(uint32_t i = 0; i < layer_size; ++i) {
+			if(province_colors[base + i] != prov_color[base + i]) {
+				first = std::min(first, i);
+				last = i;
+			}
+		}
+		if(first <= last) {
+			std::copy(prov_color.begin() + base + first, prov_color.begin() + base + last + 1, province_colors.begin() + base + first);
+			uint32_t first_row = first / 256;
+			uint32_t last_row = last / 256;
+			glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, first_row, layer, 256, last_row - first_row + 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, &province_colors[base + first_row * 256]);
+		}
+	}
+	glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
 }
 
 void add_drag_box_line(std::vector<screen_vertex>& drag_box_vertices, glm::vec2 pos1, glm::vec2 pos2, glm::vec2 size, bool vertical) {
@@ -1445,6 +1496,7 @@ void display_data::load_map(sys::state& state) {
 	glBindTexture(GL_TEXTURE_2D_ARRAY, texture_arrays[texture_array_province_color]);
 	glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, GL_RGBA8, 256, 256, 2);
 	set_gltex_parameters(texture_arrays[texture_array_province_color], GL_TEXTURE_2D_ARRAY, GL_NEAREST, GL_CLAMP_TO_EDGE);
+	province_colors.clear();
 
 	// Get the province_highlight handle
 	glGenTextures(1, &textures[texture_province_highlight]);
@@ -1457,6 +1509,7 @@ void display_data::load_map(sys::state& state) {
 	glBindTexture(GL_TEXTURE_2D, textures[texture_province_fow]);
 	glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, 256, 256);
 	set_gltex_parameters(textures[texture_province_fow], GL_TEXTURE_2D, GL_NEAREST, GL_CLAMP_TO_EDGE);
+	province_fows.clear(); // a new texture needs all of its contents
 
 	glBindTexture(GL_TEXTURE_2D, 0);
 
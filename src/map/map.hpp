@@ -6,6 +6,7 @@
 #include "glew.h"
 
 #include "map_modes.hpp"
+#include <atomic>
 #include <glm/vec2.hpp>
 #include <glm/mat4x4.hpp>
 
@@ -120,6 +121,36 @@ struct border {
 	uint16_t padding = 0;
 };
 
+// One bit per pixel edge, packed into words: edge row j * 2 holds the left edges of pixel row j and edge row j * 2 + 1
+// their bottom edges. x wraps around the international date line and edges beyond the top or bottom of the map count as
+// already visited. Bits are set atomically, so several threads may trace borders as long as they never share an edge
+struct edge_visit_map {
+	std::vector<std::atomic<uint64_t>> bits;
+	int32_t size_x = 0;
+	int32_t edge_rows = 0;
+
+	edge_visit_map(uint32_t map_size_x, uint32_t map_size_y) : bits((size_t(map_size_x) * map_size_y * 2 + 63) / 64), size_x(int32_t(map_size_x)), edge_rows(int32_t(map_size_y * 2)) { }
+
+	size_t index(int32_t i, int32_t j) const {
+		i %= size_x;
+		if(i < 0)
+			i += size_x;
+		return size_t(i) + size_t(j) * size_t(size_x);
+	}
+	bool test(int32_t i, int32_t j) const {
+		if(j < 0 || j >= edge_rows)
+			return true;
+		auto k = index(i, j);
+		return (bits[k / 64].load(std::memory_order_relaxed) & (uint64_t(1) << (k % 64))) != 0;
+	}
+	void set(int32_t i, int32_t j) {
+		if(j < 0 || j >= edge_rows)
+			return;
+		auto k = index(i, j);
+		bits[k / 64].fetch_or(uint64_t(1) << (k % 64), std::memory_order_relaxed);
+	}
+};
+
 enum class map_view;
 class display_data {
 public:
@@ -161,6 +192,11 @@ public:
 	std::vector<uint8_t> median_terrain_type;
 	std::vector<uint32_t> province_area;
 	std::vector<uint8_t> diagonal_borders;
+	// what the fog of war texture currently holds, so that an update only sends it the rows that changed
+	std::vector<uint32_t> province_fows;
+	std::vector<dcon::province_id> fow_direct_provinces;
+	// likewise for the province color texture of the current map mode
+	std::vector<uint32_t> province_colors;
 
 	// map pixel -> province id
 	std::vector<uint16_t> province_id_map;
@@ -229,8 +265,8 @@ public:
 	void load_median_terrain_type(parsers::scenario_building_context& context);
 
 	uint16_t safe_get_province(glm::ivec2 pt);
-	void make_coastal_borders(sys::state& state, std::vector<bool>& visited);
-	void make_borders(sys::state& state, std::vector<bool>& visited);
+	void make_coastal_borders(sys::state& state, edge_visit_map& visited);
+	void make_borders(sys::state& state, edge_visit_map& visited);
 
 	void load_shaders(simple_fs::directory& root);
 	void create_meshes();
@@ -115,121 +115,106 @@ int32_t get_border_index(uint16_t map_province_id1, uint16_t map_province_id2, p
 	return border_index.index();
 }
 
-void display_data::load_border_data(parsers::scenario_building_context& context) {
-	border_vertices.clear();
-
-	glm::vec2 map_size(size_x, size_y);
-
-	diagonal_borders = std::vector<uint8_t>(size_x * size_y, 0);
-
-	// The borders of the current row and last row
-	for(uint32_t y = 0; y < size_y - 1; y++) {
-		for(uint32_t x = 0; x < size_x - 1; x++) {
-			auto prov_id_ul = province_id_map[(x + 0) + (y + 0) * size_x];
-			auto prov_id_ur = province_id_map[(x + 1) + (y + 0) * size_x];
-			auto prov_id_dl = province_id_map[(x + 0) + (y + 1) * size_x];
-			auto prov_id_dr = province_id_map[(x + 1) + (y + 1) * size_x];
-
-			if(prov_id_ur == prov_id_ul && prov_id_dl == prov_id_ul && prov_id_dr != prov_id_ur) { // Upper left
-				diagonal_borders[(x + 1) + (y + 1) * uint32_t(map_size.x)] |= uint8_t(diagonal_border::UP_LEFT);
-			}
-			if(prov_id_ul == prov_id_dl && prov_id_dl == prov_id_dr && prov_id_ur != prov_id_dr) { // Lower left
-				diagonal_borders[(x + 1) + y * uint32_t(map_size.x)] |= uint8_t(diagonal_border::DOWN_LEFT);
-			}
-			if(prov_id_ul == prov_id_ur && prov_id_ur == prov_id_dr && prov_id_dl != prov_id_ul) { // Upper right
-				diagonal_borders[x + (y + 1) * uint32_t(map_size.x)] |= uint8_t(diagonal_border::UP_RIGHT);
-			}
-			if(prov_id_dl == prov_id_dr && prov_id_ur == prov_id_dr && prov_id_ul != prov_id_dl) { // Lower right
-				diagonal_borders[x + y * uint32_t(map_size.x)] |= uint8_t(diagonal_border::DOWN_RIGHT);
-			}
-			if(prov_id_ul == prov_id_dr && prov_id_ur == prov_id_dl && prov_id_ul != prov_id_ur) {
-				if((prov_id_ul >= province::to_map_id(context.state.province_definitions.first_sea_province) || prov_id_ul == 0)
-					&& (prov_id_ur < province::to_map_id(context.state.province_definitions.first_sea_province) && prov_id_ur != 0)) {
+// A pair of provinces found touching while scanning the province map; the pairs are gathered per row in parallel and
+// turned into adjacencies afterwards, in the order a serial scan would have created them
+struct border_adjacency_candidate {
+	uint16_t a = 0;
+	uint16_t b = 0;
+	bool clear_non_adjacent = false;
+
+	bool operator==(border_adjacency_candidate const& o) const {
+		return a == o.a && b == o.b && clear_non_adjacent == o.clear_non_adjacent;
+	}
+};
 
-					diagonal_borders[x + (y + 1) * uint32_t(map_size.x)] |= uint8_t(diagonal_border::UP_RIGHT);
-					diagonal_borders[(x + 1) + y * uint32_t(map_size.x)] |= uint8_t(diagonal_border::DOWN_LEFT);
+// Looks at the 2x2 block of pixels with its upper left corner at (x_left, y) and its upper right corner at (x_right, y).
+// Writes the diagonal border flags of rows y and y + 1
+void scan_border_block(display_data& dat, uint32_t x_left, uint32_t x_right, uint32_t y, uint16_t first_sea_map_id, bool clear_non_adjacent, std::vector<border_adjacency_candidate>& adjacencies) {
+	auto size_x = dat.size_x;
+	auto& diagonal_borders = dat.diagonal_borders;
 
-				} else if((prov_id_ur >= province::to_map_id(context.state.province_definitions.first_sea_province) || prov_id_ur == 0)
-					&& (prov_id_ul < province::to_map_id(context.state.province_definitions.first_sea_province) && prov_id_ul != 0)) {
+	auto prov_id_ul = dat.province_id_map[x_left + (y + 0) * size_x];
+	auto prov_id_ur = dat.province_id_map[x_right + (y + 0) * size_x];
+	auto prov_id_dl = dat.province_id_map[x_left + (y + 1) * size_x];
+	auto prov_id_dr = dat.province_id_map[x_right + (y + 1) * size_x];
 
-					diagonal_borders[(x + 1) + (y + 1) * uint32_t(map_size.x)] |= uint8_t(diagonal_border::UP_LEFT);
-					diagonal_borders[x + y * uint32_t(map_size.x)] |= uint8_t(diagonal_border::DOWN_RIGHT);
-				}
-			}
-
-			if(prov_id_ul != prov_id_ur || prov_id_ul != prov_id_dl || prov_id_ul != prov_id_dr) {
-				if(prov_id_ul != prov_id_ur && prov_id_ur != 0 && prov_id_ul != 0) {
-					context.state.world.try_create_province_adjacency(province::from_map_id(prov_id_ul), province::from_map_id(prov_id_ur));
+	if(prov_id_ur == prov_id_ul && prov_id_dl == prov_id_ul && prov_id_dr != prov_id_ur) { // Upper left
+		diagonal_borders[x_right + (y + 1) * size_x] |= uint8_t(diagonal_border::UP_LEFT);
+	}
+	if(prov_id_ul == prov_id_dl && prov_id_dl == prov_id_dr && prov_id_ur != prov_id_dr) { // Lower left
+		diagonal_borders[x_right + y * size_x] |= uint8_t(diagonal_border::DOWN_LEFT);
+	}
+	if(prov_id_ul == prov_id_ur && prov_id_ur == prov_id_dr && prov_id_dl != prov_id_ul) { // Upper right
+		diagonal_borders[x_left + (y + 1) * size_x] |= uint8_t(diagonal_border::UP_RIGHT);
+	}
+	if(prov_id_dl == prov_id_dr && prov_id_ur == prov_id_dr && prov_id_ul != prov_id_dl) { // Lower right
+		diagonal_borders[x_left + y * size_x] |= uint8_t(diagonal_border::DOWN_RIGHT);
+	}
+	if(prov_id_ul == prov_id_dr && prov_id_ur == prov_id_dl && prov_id_ul != prov_id_ur) {
+		if((prov_id_ul >= first_sea_map_id || prov_id_ul == 0)
+			&& (prov_id_ur < first_sea_map_id && prov_id_ur != 0)) {
 
-					auto aval = context.state.world.get_province_adjacency_by_province_pair(province::from_map_id(prov_id_ul), province::from_map_id(prov_id_ur));
-					if((context.state.world.province_adjacency_get_type(aval) & province::border::non_adjacent_bit) != 0)
-						context.state.world.province_adjacency_get_type(aval) &= ~(province::border::non_adjacent_bit | province::border::impassible_bit);
-					
-				}
-				if(prov_id_ul != prov_id_dl && prov_id_dl != 0 && prov_id_ul != 0) {
-					context.state.world.try_create_province_adjacency(province::from_map_id(prov_id_ul), province::from_map_id(prov_id_dl));
+			diagonal_borders[x_left + (y + 1) * size_x] |= uint8_t(diagonal_border::UP_RIGHT);
+			diagonal_borders[x_right + y * size_x] |= uint8_t(diagonal_border::DOWN_LEFT);
 
-					auto aval = context.state.world.get_province_adjacency_by_province_pair(province::from_map_id(prov_id_ul), province::from_map_id(prov_id_dl));
-					if((context.state.world.province_adjacency_get_type(aval) & province::border::non_adjacent_bit) != 0)
-							context.state.world.province_adjacency_get_type(aval) &= ~(province::border::non_adjacent_bit | province::border::impassible_bit);
-					
-				}
-				if(prov_id_ul != prov_id_dr && prov_id_dr != 0 && prov_id_ul != 0) {
-					context.state.world.try_create_province_adjacency(province::from_map_id(prov_id_ul), province::from_map_id(prov_id_dr));
+		} else if((prov_id_ur >= first_sea_map_id || prov_id_ur == 0)
+			&& (prov_id_ul < first_sea_map_id && prov_id_ul != 0)) {
 
-					auto aval = context.state.world.get_province_adjacency_by_province_pair(province::from_map_id(prov_id_ul), province::from_map_id(prov_id_dr));
-					if((context.state.world.province_adjacency_get_type(aval) & province::border::non_adjacent_bit) != 0)
-						context.state.world.province_adjacency_get_type(aval) &= ~(province::border::non_adjacent_bit | province::border::impassible_bit);
-					
-				}
-			}
+			diagonal_borders[x_right + (y + 1) * size_x] |= uint8_t(diagonal_border::UP_LEFT);
+			diagonal_borders[x_left + y * size_x] |= uint8_t(diagonal_border::DOWN_RIGHT);
 		}
+	}
 
-		{
-			// handle the international date line
-			auto prov_id_ul = province_id_map[((size_x - 1) + 0) + (y + 0) * size_x];
-			auto prov_id_ur = province_id_map[0 + (y + 0) * size_x];
-			auto prov_id_dl = province_id_map[((size_x - 1) + 0) + (y + 1) * size_x];
-			auto prov_id_dr = province_id_map[0 + (y + 1) * size_x];
-
-			if(prov_id_ur == prov_id_ul && prov_id_dl == prov_id_ul && prov_id_dr != prov_id_ur) { // Upper left
-				diagonal_borders[0 + (y + 1) * uint32_t(map_size.x)] |= uint8_t(diagonal_border::UP_LEFT);
-			}
-			if(prov_id_ul == prov_id_dl && prov_id_dl == prov_id_dr && prov_id_ur != prov_id_dr) { // Lower left
-				diagonal_borders[0 + y * uint32_t(map_size.x)] |= uint8_t(diagonal_border::DOWN_LEFT);
-			}
-			if(prov_id_ul == prov_id_ur && prov_id_ur == prov_id_dr && prov_id_dl != prov_id_ul) { // Upper right
-				diagonal_borders[(size_x - 1) + (y + 1) * uint32_t(map_size.x)] |= uint8_t(diagonal_border::UP_RIGHT);
-			}
-			if(prov_id_dl == prov_id_dr && prov_id_ur == prov_id_dr && prov_id_ul != prov_id_dl) { // Lower right
-				diagonal_borders[(size_x - 1) + y * uint32_t(map_size.x)] |= uint8_t(diagonal_border::DOWN_RIGHT);
-			}
-			if(prov_id_ul == prov_id_dr && prov_id_ur == prov_id_dl && prov_id_ul != prov_id_ur) {
-				if((prov_id_ul >= province::to_map_id(context.state.province_definitions.first_sea_province) || prov_id_ul == 0)
-					&& (prov_id_ur < province::to_map_id(context.state.province_definitions.first_sea_province) && prov_id_ur != 0)) {
+	auto add_adjacency = [&](uint16_t a, uint16_t b) {
+		border_adjacency_candidate c{ a, b, clear_non_adjacent };
+		// neighbouring blocks along a border keep finding the same pair, and creating it again would do nothing
+		if(adjacencies.empty() || !(adjacencies.back() == c))
+			adjacencies.push_back(c);
+	};
+	if(prov_id_ul != prov_id_ur && prov_id_ur != 0 && prov_id_ul != 0) {
+		add_adjacency(prov_id_ul, prov_id_ur);
+	}
+	if(prov_id_ul != prov_id_dl && prov_id_dl != 0 && prov_id_ul != 0) {
+		add_adjacency(prov_id_ul, prov_id_dl);
+	}
+	if(prov_id_ul != prov_id_dr && prov_id_dr != 0 && prov_id_ul != 0) {
+		add_adjacency(prov_id_ul, prov_id_dr);
+	}
+}
 
-					diagonal_borders[(size_x - 1) + (y + 1) * uint32_t(map_size.x)] |= uint8_t(diagonal_border::UP_RIGHT);
-					diagonal_borders[0 + y * uint32_t(map_size.x)] |= uint8_t(diagonal_border::DOWN_LEFT);
+void display_data::load_border_data(parsers::scenario_building_context& context) {
+	border_vertices.clear();
 
-				} else if((prov_id_ur >= province::to_map_id(context.state.province_definitions.first_sea_province) || prov_id_ur == 0)
-					&& (prov_id_ul < province::to_map_id(context.state.province_definitions.first_sea_province) && prov_id_ul != 0)) {
+	diagonal_borders = std::vector<uint8_t>(size_x * size_y, 0);
 
-					diagonal_borders[0 + (y + 1) * uint32_t(map_size.x)] |= uint8_t(diagonal_border::UP_LEFT);
-					diagonal_borders[(size_x - 1) + y * uint32_t(map_size.x)] |= uint8_t(diagonal_border::DOWN_RIGHT);
-				}
+	auto first_sea_map_id = province::to_map_id(context.state.province_definitions.first_sea_province);
+	uint32_t row_count = size_y - 1;
+	std::vector<std::vector<border_adjacency_candidate>> row_adjacencies(row_count);
+
+	// Each row of blocks writes diagonal flags into its own pixel row and the one below it, so the even and the odd rows
+	// are scanned in two separate passes; within a pass no two rows touch the same pixels
+	for(uint32_t parity = 0; parity < 2; ++parity) {
+		concurrency::parallel_for(uint32_t(0), (row_count + 1 - parity) / 2, [&](uint32_t i) {
+			uint32_t y = i * 2 + parity;
+			auto& adjacencies = row_adjacencies[y];
+			for(uint32_t x = 0; x < size_x - 1; x++) {
+				scan_border_block(*this, x, x + 1, y, first_sea_map_id, true, adjacencies);
 			}
+			// handle the international date line
+			scan_border_block(*this, size_x - 1, 0, y, first_sea_map_id, false, adjacencies);
+		});
+	}
 
-			if(prov_id_ul != prov_id_ur || prov_id_ul != prov_id_dl || prov_id_ul != prov_id_dr) {
-
-				if(prov_id_ul != prov_id_ur && prov_id_ur != 0 && prov_id_ul != 0) {
-					context.state.world.try_create_province_adjacency(province::from_map_id(prov_id_ul), province::from_map_id(prov_id_ur));
-				}
-				if(prov_id_ul != prov_id_dl && prov_id_dl != 0 && prov_id_ul != 0) {
-					context.state.world.try_create_province_adjacency(province::from_map_id(prov_id_ul), province::from_map_id(prov_id_dl));
-				}
-				if(prov_id_ul != prov_id_dr && prov_id_dr != 0 && prov_id_ul != 0) {
-					context.state.world.try_create_province_adjacency(province::from_map_id(prov_id_ul), province::from_map_id(prov_id_dr));
-				}
+	// The adjacencies are created from a single thread, in row order, so that their ids don't depend on scheduling
+	for(auto const& adjacencies : row_adjacencies) {
+		for(auto const& c : adjacencies) {
+			auto pa = province::from_map_id(c.a);
+			auto pb = province::from_map_id(c.b);
+			context.state.world.try_create_province_adjacency(pa, pb);
+			if(c.clear_non_adjacent) {
+				auto aval = context.state.world.get_province_adjacency_by_province_pair(pa, pb);
+				if((context.state.world.province_adjacency_get_type(aval) & province::border::non_adjacent_bit) != 0)
+					context.state.world.province_adjacency_get_type(aval) &= ~(province::border::non_adjacent_bit | province::border::impassible_bit);
 			}
 		}
 	}
@@ -271,17 +256,17 @@ bool order_indifferent_compare(uint16_t a, uint16_t b, uint16_t c, uint16_t d) {
 	return (a == c && b == d) || (a == d && b == c);
 }
 
-std::vector<glm::vec2> make_border_section(display_data& dat, sys::state& state, std::vector<bool>& visited, uint16_t prov_prim, uint16_t prov_sec, int32_t start_x, int32_t start_y) {
+std::vector<glm::vec2> make_border_section(display_data& dat, sys::state& state, edge_visit_map& visited, uint16_t prov_prim, uint16_t prov_sec, int32_t start_x, int32_t start_y) {
 	std::vector<glm::vec2> points;
 
 	auto add_next = [&](int32_t i, int32_t j, bool& next_found) {
 		if(next_found)
 			return glm::ivec2(0, 0);
-		if(visited[i + j * dat.size_x])
+		if(visited.test(i, j))
 			return glm::ivec2(0, 0);
 		if(j % 2 == 0) {
 			if(order_indifferent_compare(prov_prim, prov_sec, dat.safe_get_province(glm::ivec2(i, j / 2)), dat.safe_get_province(glm::ivec2(i - 1, j / 2)))) {
-				visited[i + j * dat.size_x] = true;
+				visited.set(i, j);
 
 				points.push_back(glm::vec2(float(i), 0.5f + float(j) / 2.0f));
 				next_found = true;
@@ -289,7 +274,7 @@ std::vector<glm::vec2> make_border_section(display_data& dat, sys::state& state,
 			}
 		} else {
 			if(order_indifferent_compare(prov_prim, prov_sec, dat.safe_get_province(glm::ivec2(i, j / 2)), dat.safe_get_province(glm::ivec2(i, j / 2 + 1)))) {
-				visited[i + j * dat.size_x] = true;
+				visited.set(i, j);
 
 				points.push_back(glm::vec2(float(i) + 0.5f, 0.5f + float(j) / 2.0f));
 				next_found = true;
@@ -302,7 +287,7 @@ std::vector<glm::vec2> make_border_section(display_data& dat, sys::state& state,
 
 
 	points.push_back(glm::vec2(float(start_x) + (start_y % 2 == 0 ? 0.0f : 0.5f), 0.5f + float(start_y) / 2.0f));
-	visited[start_x + start_y * dat.size_x] = true;
+	visited.set(start_x, start_y);
 
 	int32_t cur_x = start_x;
 	int32_t cur_y = start_y;
@@ -481,70 +466,109 @@ void add_border_segment_vertices(display_data& dat, std::vector<glm::vec2> const
 	}
 }
 
-void display_data::make_borders(sys::state& state, std::vector<bool>& visited) {
+// An edge where the scan in make_borders starts tracing a border section, if no earlier section got there first
+struct border_section_start {
+	int32_t x = 0;
+	int32_t y = 0; // edge row: y * 2 is the left edge of pixel row y, y * 2 + 1 its bottom edge
+	uint16_t prim = 0;
+	uint16_t sec = 0;
+	dcon::province_adjacency_id adj;
+};
+
+struct traced_border_section {
+	uint32_t start = 0; // index of the start in scan order
+	std::vector<glm::vec2> points;
+};
+
+void display_data::make_borders(sys::state& state, edge_visit_map& visited) {
 
 	borders.resize(state.world.province_adjacency_size());
 	for(auto adj : state.world.in_province_adjacency) {
 		borders[adj.id.index()].adj = adj;
 	}
 
-	for(int32_t j = 0; j < int32_t(size_y); ++j) {
+	// Find every edge between two different provinces, one row of pixels at a time
+	std::vector<std::vector<border_section_start>> row_starts(size_y);
+	concurrency::parallel_for(int32_t(0), int32_t(size_y), [&](int32_t j) {
+		auto& starts = row_starts[j];
 		for(int32_t i = 0; i < int32_t(size_x); ++i) {
 			// left verticals
 			{
-				bool was_visited = visited[i + (j * 2) * size_x];
-
 				auto prim = province::from_map_id(safe_get_province(glm::ivec2(i, j)));
 				auto sec = province::from_map_id(safe_get_province(glm::ivec2(i - 1, j)));
-
-				if(!was_visited && prim != sec && prim && sec) {
+				if(prim != sec && prim && sec) {
 					auto adj = state.world.get_province_adjacency_by_province_pair(prim, sec);
 					assert(adj);
-					int32_t border_index = adj.index();
-					if(borders[border_index].count != 0) {
-						border_index = int32_t(borders.size());
-						borders.emplace_back();
-						borders.back().adj = adj;
-					}
-
-					borders[border_index].start_index = int32_t(border_vertices.size());
-				
-					auto res = make_border_section(*this, state, visited, province::to_map_id(prim), province::to_map_id(sec), i, j * 2);
-					add_border_segment_vertices(*this, res);
-
-					borders[border_index].count = int32_t(border_vertices.size() - borders[border_index].start_index);
+					starts.push_back(border_section_start{ i, j * 2, province::to_map_id(prim), province::to_map_id(sec), adj });
 				}
 			}
-
 			// horizontals
 			if(j < int32_t(size_y) - 1) {
-				bool was_visited = visited[i + (j * 2 + 1) * size_x];
 				auto prim = province::from_map_id(safe_get_province(glm::ivec2(i, j)));
 				auto sec = province::from_map_id(safe_get_province(glm::ivec2(i, j + 1)));
-
-				if(!was_visited && prim != sec && prim && sec) {
+				if(prim != sec && prim && sec) {
 					auto adj = state.world.get_province_adjacency_by_province_pair(prim, sec);
 					assert(adj);
-					int32_t border_index = adj.index();
-					if(borders[border_index].count != 0) {
-						border_index = int32_t(borders.size());
-						borders.emplace_back();
-						borders.back().adj = adj;
-					}
-
-					borders[border_index].start_index = int32_t(border_vertices.size());
+					starts.push_back(border_section_start{ i, j * 2 + 1, province::to_map_id(prim), province::to_map_id(sec), adj });
+				}
+			}
+		}
+	});
+	std::vector<border_section_start> starts;
+	for(auto& r : row_starts) {
+		starts.insert(starts.end(), r.begin(), r.end());
+		r = std::vector<border_section_start>{};
+	}
 
-					auto res = make_border_section(*this, state, visited, province::to_map_id(prim), province::to_map_id(sec), i, j * 2 + 1);
-					add_border_segment_vertices(*this, res);
+	// Group the starts by adjacency, keeping them in scan order within each group
+	auto adjacency_count = state.world.province_adjacency_size();
+	std::vector<uint32_t> group_offsets(adjacency_count + 1, 0);
+	for(auto& s : starts)
+		++group_offsets[s.adj.index() + 1];
+	for(uint32_t a = 0; a < adjacency_count; ++a)
+		group_offsets[a + 1] += group_offsets[a];
+	std::vector<uint32_t> grouped(starts.size());
+	{
+		auto next = group_offsets;
+		for(uint32_t k = 0; k < uint32_t(starts.size()); ++k)
+			grouped[next[starts[k].adj.index()]++] = k;
+	}
 
-					borders[border_index].count = int32_t(border_vertices.size() - borders[border_index].start_index);
-				}
+	// A section only ever visits edges between its own two provinces, so each adjacency can be traced on its own thread and
+	// still end up with exactly the sections a single scan over the whole map would produce
+	std::vector<std::vector<traced_border_section>> traced(adjacency_count);
+	concurrency::parallel_for(uint32_t(0), adjacency_count, [&](uint32_t a) {
+		for(auto g = group_offsets[a]; g < group_offsets[a + 1]; ++g) {
+			auto const& s = starts[grouped[g]];
+			if(!visited.test(s.x, s.y)) {
+				traced[a].push_back(traced_border_section{ grouped[g], make_border_section(*this, state, visited, s.prim, s.sec, s.x, s.y) });
 			}
 		}
+	});
+
+	std::vector<traced_border_section> sections;
+	for(auto& t : traced) {
+		for(auto& s : t)
+			sections.push_back(std::move(s));
+	}
+	std::sort(sections.begin(), sections.end(), [](traced_border_section const& a, traced_border_section const& b) { return a.start < b.start; });
+
+	for(auto& s : sections) {
+		auto adj = starts[s.start].adj;
+		int32_t border_index = adj.index();
+		if(borders[border_index].count != 0) {
+			border_index = int32_t(borders.size());
+			borders.emplace_back();
+			borders.back().adj = adj;
+		}
+
+		borders[border_index].start_index = int32_t(border_vertices.size());
+		add_border_segment_vertices(*this, s.points);
+		borders[border_index].count = int32_t(border_vertices.size() - borders[border_index].start_index);
 	}
 }
 
-std::vector<glm::vec2> make_coastal_loop(display_data& dat, sys::state& state, std::vector<bool>& visited, int32_t start_x, int32_t start_y) {
+std::vector<glm::vec2> make_coastal_loop(display_data& dat, sys::state& state, edge_visit_map& visited, int32_t start_x, int32_t start_y) {
 	std::vector<glm::vec2> points;
 
 	int32_t dropped_points_counter = 0;
@@ -553,11 +577,11 @@ std::vector<glm::vec2> make_coastal_loop(display_data& dat, sys::state& state, s
 	auto add_next = [&](int32_t i, int32_t j, bool& next_found) {
 		if(next_found)
 			return glm::ivec2(0, 0);
-		if(visited[i + j  * dat.size_x])
+		if(visited.test(i, j))
 			return glm::ivec2(0, 0);
 		if(j % 2 == 0) {
 			if(coastal_point(state, dat.safe_get_province(glm::ivec2(i, j / 2)), dat.safe_get_province(glm::ivec2(i - 1, j / 2)))) {
-				visited[i + j * dat.size_x] = true;
+				visited.set(i, j);
 				
 				// test for colinearity
 				// this works, but it can result in the border textures being "slanted" because the normals are carried over between two corners
@@ -581,7 +605,7 @@ std::vector<glm::vec2> make_coastal_loop(display_data& dat, sys::state& state, s
 			}
 		} else {
 			if(coastal_point(state, dat.safe_get_province(glm::ivec2(i, j / 2)), dat.safe_get_province(glm::ivec2(i, j / 2 + 1)))) {
-				visited[i + j * dat.size_x] = true;
+				visited.set(i, j);
 
 				// test for colinearity
 				// this works, but it can result in the border textures being "slanted" because the normals are carried over between two corners
@@ -609,7 +633,7 @@ std::vector<glm::vec2> make_coastal_loop(display_data& dat, sys::state& state, s
 	};
 
 	points.push_back(glm::vec2(float(start_x) + (start_y % 2 == 0 ? 0.0f : 0.5f), 0.5f + float(start_y) / 2.0f));
-	visited[start_x + start_y * dat.size_x] = true;
+	visited.set(start_x, start_y);
 
 	bool progress = false;
 	do {
@@ -727,12 +751,12 @@ void add_coastal_loop_vertices(display_data& dat, std::vector<glm::vec2> const&
 	dat.coastal_counts.push_back(GLsizei(dat.coastal_vertices.size() - dat.coastal_starts.back()));
 }
 
-void display_data::make_coastal_borders(sys::state& state, std::vector<bool>& visited) {
+void display_data::make_coastal_borders(sys::state& state, edge_visit_map& visited) {
 	for(int32_t j = 0; j < int32_t(size_y); ++j) {
 		for(int32_t i = 0; i < int32_t(size_x); ++i) {
 			// left verticals
 			{
-				bool was_visited = visited[i + (j * 2) * size_x];
+				bool was_visited = visited.test(i, j * 2);
 				if(!was_visited && coastal_point(state, safe_get_province(glm::ivec2(i, j)), safe_get_province(glm::ivec2(i - 1, j)))) {
 					auto res = make_coastal_loop(*this, state, visited, i, j * 2);
 					add_coastal_loop_vertices(*this, res);
@@ -741,7 +765,7 @@ void display_data::make_coastal_borders(sys::state& state, std::vector<bool>& vi
 
 			// horizontals
 			if(j < int32_t(size_y) - 1) {
-				bool was_visited = visited[i + (j * 2 + 1) * size_x];
+				bool was_visited = visited.test(i, j * 2 + 1);
 				if(!was_visited && coastal_point(state, safe_get_province(glm::ivec2(i, j)), safe_get_province(glm::ivec2(i, j + 1)))) {
 					auto res = make_coastal_loop(*this, state, visited, i, j * 2 + 1);
 					add_coastal_loop_vertices(*this, res);
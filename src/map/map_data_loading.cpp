@@ -506,13 +506,11 @@ void display_data::load_map_data(parsers::scenario_building_context& context) {
 
 	create_curved_river_vertices(context, river_data, terrain_id_map);
 	{
-		std::vector<bool> borders_visited;
-		borders_visited.resize(size_x * size_y * 2, false);
+		edge_visit_map borders_visited(size_x, size_y);
 		make_coastal_borders(context.state, borders_visited);
 	}
 	{
-		std::vector<bool> borders_visited;
-		borders_visited.resize(size_x * size_y * 2, false);
+		edge_visit_map borders_visited(size_x, size_y);
 		make_borders(context.state, borders_visited);
 	}
 }
@@ -58,6 +58,59 @@ std::vector<uint32_t> select_states_map_from(sys::state& state) {
 
 namespace map_mode {
 
+// what the colors of a map mode are computed from, besides the scenario itself
+constexpr inline uint8_t input_world = 0x01;     // the game state, see map_state::world_version
+constexpr inline uint8_t input_selection = 0x02; // the selected province
+constexpr inline uint8_t input_player = 0x04;    // the local player
+constexpr inline uint8_t input_settings = 0x08;  // user settings
+constexpr inline uint8_t input_uncached = 0x80;  // anything else: always recomputed
+
+uint8_t mode_inputs(mode m) {
+	switch(m) {
+	case mode::region:
+		return 0;
+	case mode::political:
+		return input_world | input_settings;
+	case mode::rank:
+	case mode::supply:
+	case mode::civilization_level:
+	case mode::party_loyalty:
+	case mode::crisis:
+		return input_world;
+	case mode::population:
+	case mode::nationality:
+	case mode::sphere:
+	case mode::migration:
+	case mode::rgo_output:
+	case mode::religion:
+		return input_world | input_selection;
+	case mode::recruitment:
+	case mode::infrastructure:
+	case mode::revolt:
+	case mode::admin:
+	case mode::naval:
+	case mode::national_focus:
+	case mode::colonial:
+		return input_world | input_player;
+	case mode::diplomatic:
+	case mode::relation:
+		return input_world | input_selection | input_player;
+	default:
+		return input_uncached;
+	}
+}
+
+// the last colors computed for each mode, and what they were computed from
+struct mode_color_cache {
+	std::vector<uint32_t> colors;
+	uint32_t world_version = 0;
+	dcon::province_id selection;
+	dcon::nation_id player;
+	uint8_t vassal_color = 0;
+	bool valid = false;
+};
+static std::array<mode_color_cache, 256> mode_color_caches;
+
 void set_map_mode(sys::state& state, mode mode) {
 	std::vector<uint32_t> prov_color;
 
@@ -129,6 +182,17 @@ void set_map_mode(sys::state& state, mode mode) {
 			state.ui_state.map_rec_legend->set_visible(state, false);
 	}
 
+	auto& cache = mode_color_caches[uint8_t(mode)];
+	auto inputs = mode_inputs(mode);
+	if(cache.valid && (inputs & input_uncached) == 0
+		&& ((inputs & input_world) == 0 || cache.world_version == state.map_state.world_version)
+		&& ((inputs & input_selection) == 0 || cache.selection == state.map_state.selected_province)
+		&& ((inputs & input_player) == 0 || cache.player == state.local_player_nation)
+		&& ((inputs & input_settings) == 0 || cache.vassal_color == uint8_t(state.user_settings.vassal_color))) {
+		state.map_state.set_province_color(cache.colors, mode);
+		return;
+	}
+
 	switch(mode) {
 	case mode::state_select:
 		prov_color = select_states_map_from(state);
@@ -209,7 +273,14 @@ void set_map_mode(sys::state& state, mode mode) {
 	default:
 		return;
 	}
-	state.map_state.set_province_color(prov_color, mode);
+
+	cache.colors = std::move(prov_color);
+	cache.world_version = state.map_state.world_version;
+	cache.selection = state.map_state.selected_province;
+	cache.player = state.local_player_nation;
+	cache.vassal_color = uint8_t(state.user_settings.vassal_color);
+	cache.valid = true;
+	state.map_state.set_province_color(cache.colors, mode);
 }
 
 void update_map_mode(sys::state& state) {
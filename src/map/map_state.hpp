@@ -54,6 +54,7 @@ public:
 
 	map_mode::mode active_map_mode = map_mode::mode::terrain;
 	dcon::province_id selected_province = dcon::province_id{};
+	uint32_t world_version = 0; // bumped by the ui whenever it learns that the game state has changed
 
 	display_data map_data;
 	bool is_dragging = false;
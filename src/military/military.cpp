@@ -76,6 +76,7 @@ void restore_unsaved_values(sys::state& state) {
 			state.world.nation_set_is_at_war(n, true);
 		}
 	});
+	rebuild_relationship_matrix(state);
 	update_all_recruitable_regiments(state);
 	regenerate_total_regiment_counts(state);
 	update_naval_supply_points(state);
@@ -430,7 +431,13 @@ bool compute_blockade_status(sys::state& state, dcon::province_id p) {
 	auto port_to = state.world.province_get_port_to(p);
 	if(!port_to)
 		return false;
-	
+
+	if(state.world.province_get_navy_presence(port_to) == 0)
+		return false;
+	if(!state.world.province_get_navy_presence_mixed(port_to)
+		&& !military::are_at_war(state, owner, state.world.province_get_navy_presence_controller(port_to)))
+		return false;
+
 	for(auto n : state.world.province_get_navy_location(port_to)) {
 		if(n.get_navy().get_is_retreating() == false && !n.get_navy().get_battle_from_navy_battle_participation()) {
 			if(military::are_at_war(state, owner, n.get_navy().get_controller_from_navy_control()))
@@ -446,6 +453,49 @@ void update_blockade_status(sys::state& state) {
 	});
 }
 
+void note_army_presence(sys::state& state, dcon::army_id a, dcon::province_id p) {
+	if(!p)
+		return;
+	auto controller = state.world.army_get_controller_from_army_control(a);
+	auto& count = state.world.province_get_army_presence(p);
+	if(count == 0)
+		state.world.province_set_army_presence_controller(p, controller);
+	else if(state.world.province_get_army_presence_controller(p) != controller)
+		state.world.province_set_army_presence_mixed(p, true);
+	if(count != std::numeric_limits<uint16_t>::max())
+		++count;
+}
+
+void note_navy_presence(sys::state& state, dcon::navy_id n, dcon::province_id p) {
+	if(!p)
+		return;
+	auto controller = state.world.navy_get_controller_from_navy_control(n);
+	auto& count = state.world.province_get_navy_presence(p);
+	if(count == 0)
+		state.world.province_set_navy_presence_controller(p, controller);
+	else if(state.world.province_get_navy_presence_controller(p) != controller)
+		state.world.province_set_navy_presence_mixed(p, true);
+	if(count != std::numeric_limits<uint16_t>::max())
+		++count;
+}
+
+void update_unit_presence(sys::state& state) {
+	state.world.for_each_province([&](dcon::province_id p) {
+		state.world.province_set_army_presence(p, uint16_t(0));
+		state.world.province_set_army_presence_controller(p, dcon::nation_id{});
+		state.world.province_set_army_presence_mixed(p, false);
+		state.world.province_set_navy_presence(p, uint16_t(0));
+		state.world.province_set_navy_presence_controller(p, dcon::nation_id{});
+		state.world.province_set_navy_presence_mixed(p, false);
+	});
+	for(auto a : state.world.in_army) {
+		note_army_presence(state, a, a.get_location_from_army_location());
+	}
+	for(auto n : state.world.in_navy) {
+		note_navy_presence(state, n, n.get_location_from_navy_location());
+	}
+}
+
 template<typename T>
 auto province_is_under_siege(sys::state const& state, T ids) {
 	return state.world.province_get_siege_progress(ids) > 0.0f;
@@ -482,36 +532,112 @@ bool state_has_naval_base(sys::state const& state, dcon::state_instance_id si) {
 	return false;
 }
 
-bool are_at_war(sys::state const& state, dcon::nation_id a, dcon::nation_id b) {
-	for(auto wa : state.world.nation_get_war_participant(a)) {
-		auto is_attacker = wa.get_is_attacker();
-		for(auto o : wa.get_war().get_war_participant()) {
-			if(o.get_nation() == b)
-				return o.get_is_attacker() != is_attacker;
-		}
+static void clear_relationship_row(std::vector<uint64_t>& m, dcon::nation_id n) {
+	if(m.empty())
+		return;
+	std::fill_n(m.begin() + n.index() * relationship_matrix::words_per_row, relationship_matrix::words_per_row, uint64_t(0));
+	for(uint32_t i = 0; i < relationship_matrix::max_nations; ++i)
+		relationship_matrix::set(m, dcon::nation_id{ dcon::nation_id::value_base_t(i) }, n, false);
+}
+
+static void set_war_relationships(sys::state& state, dcon::war_id w, dcon::nation_id n, bool is_attacker) {
+	auto& rel = state.military_definitions.relationships;
+	province::invalidate_land_access(state, n);
+	for(auto o : state.world.war_get_war_participant(w)) { // includes n itself, which counts as its own ally
+		province::invalidate_land_access(state, o.get_nation());
+		auto& m = o.get_is_attacker() != is_attacker ? rel.at_war : rel.allied_in_war;
+		relationship_matrix::set(m, n, o.get_nation().id, true);
+		relationship_matrix::set(m, o.get_nation().id, n, true);
 	}
-	return false;
 }
 
-bool are_allied_in_war(sys::state const& state, dcon::nation_id a, dcon::nation_id b) {
-	for(auto wa : state.world.nation_get_war_participant(a)) {
-		auto is_attacker = wa.get_is_attacker();
-		for(auto o : wa.get_war().get_war_participant()) {
-			if(o.get_nation() == b)
-				return o.get_is_attacker() == is_attacker;
+// recomputes the war bits involving n from the wars that n is still participating in
+static void refresh_war_relationships(sys::state& state, dcon::nation_id n) {
+	auto& rel = state.military_definitions.relationships;
+	// whoever n shared a war with may lose its access through n, and n through them
+	province::invalidate_land_access(state, n);
+	for(uint32_t i = 0; i < relationship_matrix::max_nations; ++i) {
+		dcon::nation_id o{ dcon::nation_id::value_base_t(i) };
+		if(relationship_matrix::get(rel.at_war, n, o) || relationship_matrix::get(rel.allied_in_war, n, o))
+			province::invalidate_land_access(state, o);
+	}
+	clear_relationship_row(rel.at_war, n);
+	clear_relationship_row(rel.allied_in_war, n);
+	for(auto wa : state.world.nation_get_war_participant(n)) {
+		set_war_relationships(state, wa.get_war().id, n, wa.get_is_attacker());
+	}
+}
+
+void rebuild_relationship_matrix(sys::state& state) {
+	auto& rel = state.military_definitions.relationships;
+	auto size = size_t(relationship_matrix::max_nations) * relationship_matrix::words_per_row;
+	rel.at_war.assign(size, 0);
+	rel.allied_in_war.assign(size, 0);
+	rel.military_access.assign(size, 0);
+	province::invalidate_land_access(state);
+
+	for(auto w : state.world.in_war) {
+		for(auto p : w.get_war_participant()) {
+			set_war_relationships(state, w.id, p.get_nation().id, p.get_is_attacker());
 		}
 	}
-	return false;
+	for(auto ur : state.world.in_unilateral_relationship) {
+		if(ur.get_military_access())
+			relationship_matrix::set(rel.military_access, ur.get_target().id, ur.get_source().id, true);
+	}
 }
 
-bool are_in_common_war(sys::state const& state, dcon::nation_id a, dcon::nation_id b) {
-	for(auto wa : state.world.nation_get_war_participant(a)) {
-		for(auto o : wa.get_war().get_war_participant()) {
-			if(o.get_nation() == b)
-				return true;
+void reset_relationships(sys::state& state, dcon::nation_id n) {
+	auto& rel = state.military_definitions.relationships;
+	for(uint32_t i = 0; i < relationship_matrix::max_nations; ++i) {
+		dcon::nation_id o{ dcon::nation_id::value_base_t(i) };
+		if(relationship_matrix::get(rel.military_access, o, n))
+			province::invalidate_land_access(state, o);
+	}
+	province::invalidate_land_access(state, n);
+	clear_relationship_row(rel.military_access, n);
+	refresh_war_relationships(state, n);
+}
+
+void validate_relationship_matrix(sys::state const& state) {
+#ifndef NDEBUG
+	auto& rel = state.military_definitions.relationships;
+	auto size = size_t(relationship_matrix::max_nations) * relationship_matrix::words_per_row;
+	std::vector<uint64_t> at_war(size, 0);
+	std::vector<uint64_t> allied_in_war(size, 0);
+	std::vector<uint64_t> military_access(size, 0);
+
+	for(uint32_t i = 0; i < state.world.nation_size(); ++i) {
+		dcon::nation_id a{ dcon::nation_id::value_base_t(i) };
+		for(auto wa : state.world.nation_get_war_participant(a)) {
+			for(auto o : wa.get_war().get_war_participant()) {
+				relationship_matrix::set(o.get_is_attacker() != wa.get_is_attacker() ? at_war : allied_in_war, a, o.get_nation().id, true);
+			}
 		}
 	}
-	return false;
+	for(uint32_t i = 0; i < state.world.unilateral_relationship_size(); ++i) {
+		dcon::unilateral_relationship_id ur{ dcon::unilateral_relationship_id::value_base_t(i) };
+		if(state.world.unilateral_relationship_is_valid(ur) && state.world.unilateral_relationship_get_military_access(ur))
+			relationship_matrix::set(military_access, state.world.unilateral_relationship_get_target(ur), state.world.unilateral_relationship_get_source(ur), true);
+	}
+
+	assert(rel.at_war == at_war);
+	assert(rel.allied_in_war == allied_in_war);
+	assert(rel.military_access == military_access);
+#endif
+}
+
+bool are_at_war(sys::state const& state, dcon::nation_id a, dcon::nation_id b) {
+	return relationship_matrix::get(state.military_definitions.relationships.at_war, a, b);
+}
+
+bool are_allied_in_war(sys::state const& state, dcon::nation_id a, dcon::nation_id b) {
+	return relationship_matrix::get(state.military_definitions.relationships.allied_in_war, a, b);
+}
+
+bool are_in_common_war(sys::state const& state, dcon::nation_id a, dcon::nation_id b) {
+	auto& rel = state.military_definitions.relationships;
+	return relationship_matrix::get(rel.at_war, a, b) || relationship_matrix::get(rel.allied_in_war, a, b);
 }
 
 struct participation {
@@ -520,6 +646,8 @@ struct participation {
 };
 
 participation internal_find_war_between(sys::state const& state, dcon::nation_id a, dcon::nation_id b) {
+	if(!are_at_war(state, a, b))
+		return participation{};
 	for(auto wa : state.world.nation_get_war_participant(a)) {
 		auto is_attacker = wa.get_is_attacker();
 		for(auto o : wa.get_war().get_war_participant()) {
@@ -2061,12 +2189,16 @@ void give_military_access(sys::state& state, dcon::nation_id accessing_nation, d
 		ur = state.world.force_create_unilateral_relationship(target, accessing_nation);
 	}
 	state.world.unilateral_relationship_set_military_access(ur, true);
+	relationship_matrix::set(state.military_definitions.relationships.military_access, accessing_nation, target, true);
+	province::invalidate_land_access(state, accessing_nation);
 }
 void remove_military_access(sys::state& state, dcon::nation_id accessing_nation, dcon::nation_id target) {
 	auto ur = state.world.get_unilateral_relationship_by_unilateral_pair(target, accessing_nation);
 	if(ur) {
 		state.world.unilateral_relationship_set_military_access(ur, false);
 	}
+	relationship_matrix::set(state.military_definitions.relationships.military_access, accessing_nation, target, false);
+	province::invalidate_land_access(state, accessing_nation);
 }
 
 void end_wars_between(sys::state& state, dcon::nation_id a, dcon::nation_id b) {
@@ -2101,6 +2233,7 @@ void add_to_war(sys::state& state, dcon::war_id w, dcon::nation_id n, bool as_at
 
 	auto participant = state.world.force_create_war_participant(w, n);
 	state.world.war_participant_set_is_attacker(participant, as_attacker);
+	set_war_relationships(state, w, n, as_attacker);
 	state.world.nation_set_is_at_war(n, true);
 	state.world.nation_set_disarmed_until(n, sys::date{});
 
@@ -2615,6 +2748,7 @@ void remove_from_war(sys::state& state, dcon::war_id w, dcon::nation_id n, bool
 	}
 
 	state.world.delete_war_participant(par);
+	refresh_war_relationships(state, n);
 	auto rem_wars = state.world.nation_get_war_participant(n);
 	if(rem_wars.begin() == rem_wars.end()) {
 		state.world.nation_set_is_at_war(n, false);
@@ -2708,6 +2842,7 @@ void take_from_sphere(sys::state& state, dcon::nation_id member, dcon::nation_id
 		state.world.gp_relationship_get_status(rel) &= ~nations::influence::level_mask;
 		state.world.gp_relationship_get_status(rel) |= nations::influence::level_hostile;
 		state.world.nation_set_in_sphere_of(member, dcon::nation_id{});
+		province::invalidate_land_access(state, existing_sphere_leader);
 	}
 
 	if(!nations::is_great_power(state, new_gp))
@@ -2724,6 +2859,7 @@ void take_from_sphere(sys::state& state, dcon::nation_id member, dcon::nation_id
 	state.world.gp_relationship_get_status(nrel) |= nations::influence::level_in_sphere;
 	state.world.gp_relationship_set_influence(nrel, state.defines.max_influence);
 	state.world.nation_set_in_sphere_of(member, new_gp);
+	province::invalidate_land_access(state, new_gp);
 }
 
 void implement_war_goal(sys::state& state, dcon::war_id war, dcon::cb_type_id wargoal, dcon::nation_id from,
@@ -4039,7 +4175,13 @@ void army_arrives_in_province(sys::state& state, dcon::army_id a, dcon::province
 	assert(state.world.army_is_valid(a));
 	assert(!state.world.army_get_battle_from_army_battle_participation(a));
 
+	// if every army that has been here shares our controller, none of them can be fought
+	bool may_meet_enemy = state.world.province_get_army_presence(p) != 0
+		&& (state.world.province_get_army_presence_mixed(p)
+			|| state.world.province_get_army_presence_controller(p) != state.world.army_get_controller_from_army_control(a));
+
 	state.world.army_set_location_from_army_location(a, p);
+	note_army_presence(state, a, p);
 	auto regs = state.world.army_get_army_membership(a);
 	if(!state.world.army_get_black_flag(a) && !state.world.army_get_is_retreating(a) && regs.begin() != regs.end()) {
 		auto owner_nation = state.world.army_get_controller_from_army_control(a);
@@ -4065,74 +4207,76 @@ void army_arrives_in_province(sys::state& state, dcon::army_id a, dcon::province
 		dcon::land_battle_id gather_to_battle;
 		dcon::war_id battle_in_war;
 
-		for(auto o : state.world.province_get_army_location(p)) {
-			if(o.get_army() == a)
-				continue;
-			if(o.get_army().get_is_retreating() || o.get_army().get_black_flag() || o.get_army().get_navy_from_army_transport() || o.get_army().get_battle_from_army_battle_participation())
-				continue;
-
-			auto other_nation = o.get_army().get_controller_from_army_control();
-
-			if(bool(owner_nation) != bool(other_nation)) { // battle vs. rebels
-				auto new_battle = fatten(state.world, state.world.create_land_battle());
-				new_battle.set_war_attacker_is_attacker(!bool(owner_nation));
-				new_battle.set_start_date(state.current_date);
-				new_battle.set_location_from_land_battle_location(p);
-				new_battle.set_dice_rolls(make_dice_rolls(state, uint32_t(new_battle.id.value)));
-
-				uint8_t flags = defender_bonus_dig_in_mask;
-				if(crossing == crossing_type::river)
-					flags |= defender_bonus_crossing_river;
-				if(crossing == crossing_type::sea)
-					flags |= defender_bonus_crossing_sea;
-				new_battle.set_defender_bonus(flags);
-
-				auto cw_a = state.defines.base_combat_width -
-					state.world.nation_get_modifier_values(owner_nation, sys::national_mod_offsets::combat_width);
-				auto cw_b = state.defines.base_combat_width -
-					state.world.nation_get_modifier_values(other_nation, sys::national_mod_offsets::combat_width);
-				new_battle.set_combat_width(uint8_t(
-					std::clamp(int32_t(std::min(cw_a, cw_b) *
-						(state.world.province_get_modifier_values(p, sys::provincial_mod_offsets::combat_width) + 1.0f)),
-						2, 30)));
-
-				add_army_to_battle(state, a, new_battle, !bool(owner_nation) ? war_role::attacker : war_role::defender);
-				add_army_to_battle(state, o.get_army(), new_battle, bool(owner_nation) ? war_role::attacker : war_role::defender);
-
-				gather_to_battle = new_battle.id;
-				break;
-			} else if(auto par = internal_find_war_between(state, owner_nation, other_nation); par.role != war_role::none) {
-				auto new_battle = fatten(state.world, state.world.create_land_battle());
-				new_battle.set_war_attacker_is_attacker(par.role == war_role::attacker);
-				new_battle.set_start_date(state.current_date);
-				new_battle.set_war_from_land_battle_in_war(par.w);
-				new_battle.set_location_from_land_battle_location(p);
-				new_battle.set_dice_rolls(make_dice_rolls(state, uint32_t(new_battle.id.value)));
+		if(may_meet_enemy) {
+			for(auto o : state.world.province_get_army_location(p)) {
+				if(o.get_army() == a)
+					continue;
+				if(o.get_army().get_is_retreating() || o.get_army().get_black_flag() || o.get_army().get_navy_from_army_transport() || o.get_army().get_battle_from_army_battle_participation())
+					continue;
 
-				uint8_t flags = defender_bonus_dig_in_mask;
-				if(crossing == crossing_type::river)
-					flags |= defender_bonus_crossing_river;
-				if(crossing == crossing_type::sea)
-					flags |= defender_bonus_crossing_sea;
-				new_battle.set_defender_bonus(flags);
-
-				auto cw_a = state.defines.base_combat_width -
-					state.world.nation_get_modifier_values(owner_nation, sys::national_mod_offsets::combat_width);
-				auto cw_b = state.defines.base_combat_width -
-					state.world.nation_get_modifier_values(other_nation, sys::national_mod_offsets::combat_width);
-				new_battle.set_combat_width(uint8_t(
-					std::clamp(int32_t(std::min(cw_a, cw_b) *
-						(state.world.province_get_modifier_values(p, sys::provincial_mod_offsets::combat_width) + 1.0f)),
-						2, 30)));
-
-				add_army_to_battle(state, a, new_battle, par.role);
-				add_army_to_battle(state, o.get_army(), new_battle, par.role == war_role::attacker ? war_role::defender : war_role::attacker);
+				auto other_nation = o.get_army().get_controller_from_army_control();
 
-				gather_to_battle = new_battle.id;
-				battle_in_war = par.w;
-				break;
-			}
+				if(bool(owner_nation) != bool(other_nation)) { // battle vs. rebels
+					auto new_battle = fatten(state.world, state.world.create_land_battle());
+					new_battle.set_war_attacker_is_attacker(!bool(owner_nation));
+					new_battle.set_start_date(state.current_date);
+					new_battle.set_location_from_land_battle_location(p);
+					new_battle.set_dice_rolls(make_dice_rolls(state, uint32_t(new_battle.id.value)));
+
+					uint8_t flags = defender_bonus_dig_in_mask;
+					if(crossing == crossing_type::river)
+						flags |= defender_bonus_crossing_river;
+					if(crossing == crossing_type::sea)
+						flags |= defender_bonus_crossing_sea;
+					new_battle.set_defender_bonus(flags);
+
+					auto cw_a = state.defines.base_combat_width -
+						state.world.nation_get_modifier_values(owner_nation, sys::national_mod_offsets::combat_width);
+					auto cw_b = state.defines.base_combat_width -
+						state.world.nation_get_modifier_values(other_nation, sys::national_mod_offsets::combat_width);
+					new_battle.set_combat_width(uint8_t(
+						std::clamp(int32_t(std::min(cw_a, cw_b) *
+							(state.world.province_get_modifier_values(p, sys::provincial_mod_offsets::combat_width) + 1.0f)),
+							2, 30)));
+
+					add_army_to_battle(state, a, new_battle, !bool(owner_nation) ? war_role::attacker : war_role::defender);
+					add_army_to_battle(state, o.get_army(), new_battle, bool(owner_nation) ? war_role::attacker : war_role::defender);
+
+					gather_to_battle = new_battle.id;
+					break;
+				} else if(auto par = internal_find_war_between(state, owner_nation, other_nation); par.role != war_role::none) {
+					auto new_battle = fatten(state.world, state.world.create_land_battle());
+					new_battle.set_war_attacker_is_attacker(par.role == war_role::attacker);
+					new_battle.set_start_date(state.current_date);
+					new_battle.set_war_from_land_battle_in_war(par.w);
+					new_battle.set_location_from_land_battle_location(p);
+					new_battle.set_dice_rolls(make_dice_rolls(state, uint32_t(new_battle.id.value)));
+
+					uint8_t flags = defender_bonus_dig_in_mask;
+					if(crossing == crossing_type::river)
+						flags |= defender_bonus_crossing_river;
+					if(crossing == crossing_type::sea)
+						flags |= defender_bonus_crossing_sea;
+					new_battle.set_defender_bonus(flags);
+
+					auto cw_a = state.defines.base_combat_width -
+						state.world.nation_get_modifier_values(owner_nation, sys::national_mod_offsets::combat_width);
+					auto cw_b = state.defines.base_combat_width -
+						state.world.nation_get_modifier_values(other_nation, sys::national_mod_offsets::combat_width);
+					new_battle.set_combat_width(uint8_t(
+						std::clamp(int32_t(std::min(cw_a, cw_b) *
+							(state.world.province_get_modifier_values(p, sys::provincial_mod_offsets::combat_width) + 1.0f)),
+							2, 30)));
+
+					add_army_to_battle(state, a, new_battle, par.role);
+					add_army_to_battle(state, o.get_army(), new_battle, par.role == war_role::attacker ? war_role::defender : war_role::attacker);
+
+					gather_to_battle = new_battle.id;
+					battle_in_war = par.w;
+					break;
+				}
 			
+			}
 		}
 
 		if(gather_to_battle) {
@@ -4477,6 +4621,7 @@ void end_battle(sys::state& state, dcon::land_battle_id b, battle_result result)
 		state.world.army_set_controller_from_army_control(a, dcon::nation_id{});
 		state.world.army_set_controller_from_army_rebel_control(a, dcon::rebel_faction_id{});
 		state.world.army_set_is_retreating(a, true);
+		note_army_presence(state, a, location);
 	};
 
 	auto a_nation = get_land_battle_lead_attacker(state, b);
@@ -5101,6 +5246,18 @@ void apply_regiment_damage(sys::state& state) {
 	}
 }
 
+void compute_land_combat_damage(land_combat_lanes& lanes) {
+	// only multiplications and divisions, grouped as in the scalar expressions, so there is nothing here for the
+	// compiler to fuse or reassociate when it vectorizes the loop
+	for(int32_t i = 0; i < lanes.count; ++i) {
+		lanes.str_damage[i] = str_dam_mul * lanes.power[i] * lanes.support[i] * lanes.side_mod[i] / (lanes.fort[i] * lanes.tactics[i]);
+		lanes.org_damage[i] = org_dam_mul * lanes.power[i] * lanes.support[i] * lanes.side_mod[i] /
+			(lanes.fort[i] * lanes.org_first[i] * lanes.org_second[i] * lanes.org_defense[i]);
+	}
+}
+
+static thread_local land_combat_lanes combat_lanes;
+
 void update_land_battles(sys::state& state) {
 	auto isize = state.world.land_battle_size();
 	auto to_delete = ve::vectorizable_buffer<uint8_t, dcon::land_battle_id>(isize);
@@ -5217,92 +5374,55 @@ void update_land_battles(sys::state& state) {
 		float attacker_casualties = 0;
 		float defender_casualties = 0;
 
+		// first we find who shoots at whom, in the order the shots used to be applied in, then the damage of all of them
+		// is worked out at once, and finally it is applied in that same order
+
+		auto& lanes = combat_lanes;
+		lanes.count = 0;
+
+		auto add_shot = [&](dcon::regiment_id from, dcon::regiment_id to, bool to_attacker, bool from_back_line) {
+			auto tech_from_nation = tech_nation_for_regiment(state, from);
+			auto tech_to_nation = tech_nation_for_regiment(state, to);
+
+			auto& from_stats = state.world.nation_get_unit_stats(tech_from_nation, state.world.regiment_get_type(from));
+			auto& to_stats = state.world.nation_get_unit_stats(tech_to_nation, state.world.regiment_get_type(to));
+
+			auto k = lanes.count++;
+			lanes.power[k] = from_stats.attack_or_gun_power * 0.1f + 1.0f;
+			lanes.support[k] = from_back_line ? from_stats.support : 1.0f;
+			lanes.side_mod[k] = to_attacker ? defender_mod : attacker_mod;
+			lanes.fort[k] = to_attacker ? 1.0f : defender_fort;
+			lanes.tactics[k] = state.defines.base_military_tactics + state.world.nation_get_modifier_values(tech_to_nation, sys::national_mod_offsets::military_tactics);
+			// shots at the defender use the discipline of the target, shots at the attacker that of the shooter
+			if(to_attacker) {
+				lanes.org_first[k] = attacker_org_bonus;
+				lanes.org_second[k] = from_stats.discipline_or_evasion;
+			} else if(from_back_line) {
+				lanes.org_first[k] = defender_org_bonus;
+				lanes.org_second[k] = to_stats.discipline_or_evasion;
+			} else {
+				lanes.org_first[k] = to_stats.discipline_or_evasion;
+				lanes.org_second[k] = defender_org_bonus;
+			}
+			lanes.org_defense[k] = 1.0f + state.world.nation_get_modifier_values(tech_to_nation, sys::national_mod_offsets::land_organisation);
+			lanes.target[k] = to;
+			lanes.target_is_attacker[k] = to_attacker;
+		};
+
 		for(int32_t i = 0; i < combat_width; ++i) {
 			if(att_back[i] && def_front[i]) {
 				assert(state.world.regiment_is_valid(att_back[i]) && state.world.regiment_is_valid(def_front[i]));
-
-				auto tech_att_nation = tech_nation_for_regiment(state, att_back[i]);
-				auto tech_def_nation = tech_nation_for_regiment(state, def_front[i]);
-
-				auto& att_stats = state.world.nation_get_unit_stats(tech_att_nation, state.world.regiment_get_type(att_back[i]));
-				auto& def_stats = state.world.nation_get_unit_stats(tech_def_nation, state.world.regiment_get_type(def_front[i]));
-
-				auto str_damage = str_dam_mul *
-						(att_stats.attack_or_gun_power * 0.1f + 1.0f) * att_stats.support * attacker_mod /
-						(defender_fort * (state.defines.base_military_tactics + state.world.nation_get_modifier_values(tech_def_nation, sys::national_mod_offsets::military_tactics)));
-				auto org_damage = org_dam_mul *
-						(att_stats.attack_or_gun_power * 0.1f + 1.0f) * att_stats.support * attacker_mod /
-						(defender_fort * defender_org_bonus * def_stats.discipline_or_evasion *
-								(1.0f + state.world.nation_get_modifier_values(tech_def_nation, sys::national_mod_offsets::land_organisation)));
-
-				auto& cstr = state.world.regiment_get_strength(def_front[i]);
-				str_damage = std::min(str_damage, cstr);
-				state.world.regiment_get_pending_damage(def_front[i]) += str_damage;
-				cstr -= str_damage;
-				defender_casualties += str_damage;
-
-				auto& org = state.world.regiment_get_org(def_front[i]);
-				org = std::max(0.0f, org - org_damage);
-				switch(state.military_definitions.unit_base_definitions[state.world.regiment_get_type(def_front[i])].type) {
-					case unit_type::infantry:
-						state.world.land_battle_get_defender_infantry_lost(b) += str_damage;
-						break;
-					case unit_type::cavalry:
-						state.world.land_battle_get_defender_cav_lost(b) += str_damage;
-						break;
-					case unit_type::support:
-						// fallthrough
-					case unit_type::special:
-						state.world.land_battle_get_defender_support_lost(b) += str_damage;
-						break;
-					default:
-						break;
-				}
+				add_shot(att_back[i], def_front[i], false, true);
 			}
 
 			if(def_back[i] && att_front[i]) {
 				assert(state.world.regiment_is_valid(def_back[i]) && state.world.regiment_is_valid(att_front[i]));
-
-				auto tech_def_nation = tech_nation_for_regiment(state, def_back[i]);
-				auto tech_att_nation = tech_nation_for_regiment(state, att_front[i]);
-
-				auto& def_stats = state.world.nation_get_unit_stats(tech_def_nation, state.world.regiment_get_type(def_back[i]));
-				auto& att_stats = state.world.nation_get_unit_stats(tech_att_nation, state.world.regiment_get_type(att_front[i]));
-
-				auto str_damage = str_dam_mul * (def_stats.attack_or_gun_power * 0.1f + 1.0f) * def_stats.support * defender_mod / ((state.defines.base_military_tactics + state.world.nation_get_modifier_values(tech_att_nation, sys::national_mod_offsets::military_tactics)));
-				auto org_damage = org_dam_mul * (def_stats.attack_or_gun_power * 0.1f + 1.0f) * def_stats.support * defender_mod / (attacker_org_bonus * def_stats.discipline_or_evasion * (1.0f + state.world.nation_get_modifier_values(tech_att_nation, sys::national_mod_offsets::land_organisation)));
-
-				auto& cstr = state.world.regiment_get_strength(att_front[i]);
-				str_damage = std::min(str_damage, cstr);
-				state.world.regiment_get_pending_damage(att_front[i]) += str_damage;
-				cstr -= str_damage;
-				attacker_casualties += str_damage;
-
-				auto& org = state.world.regiment_get_org(att_front[i]);
-				org = std::max(0.0f, org - org_damage);
-				switch(state.military_definitions.unit_base_definitions[state.world.regiment_get_type(att_front[i])].type) {
-					case unit_type::infantry:
-						state.world.land_battle_get_attacker_infantry_lost(b) += str_damage;
-						break;
-					case unit_type::cavalry:
-						state.world.land_battle_get_attacker_cav_lost(b) += str_damage;
-						break;
-					case unit_type::support:
-						// fallthrough
-					case unit_type::special:
-						state.world.land_battle_get_attacker_support_lost(b) += str_damage;
-						break;
-					default:
-						break;
-				}
+				add_shot(def_back[i], att_front[i], true, true);
 			}
 
 			if(att_front[i]) {
 				assert(state.world.regiment_is_valid(att_front[i]));
 
-				auto tech_att_nation = tech_nation_for_regiment(state, att_front[i]);
-				auto& att_stats = state.world.nation_get_unit_stats(tech_att_nation, state.world.regiment_get_type(att_front[i]));
-
 				auto att_front_target = def_front[i];
 				if(auto mv = state.military_definitions.unit_base_definitions[state.world.regiment_get_type(att_front[i])].maneuver; !att_front_target && mv > 0.0f) {
 					for(int32_t cnt = 1; i - cnt * 2 >= 0 && cnt <= int32_t(mv); ++cnt) {
@@ -5315,49 +5435,13 @@ void update_land_battles(sys::state& state) {
 
 				if(att_front_target) {
 					assert(state.world.regiment_is_valid(att_front_target));
-
-					auto tech_def_nation = tech_nation_for_regiment(state, att_front_target);
-					auto& def_stats = state.world.nation_get_unit_stats(tech_def_nation, state.world.regiment_get_type(att_front_target));
-
-					auto str_damage = str_dam_mul *
-							(att_stats.attack_or_gun_power * 0.1f + 1.0f) * attacker_mod /
-							(defender_fort * (state.defines.base_military_tactics + state.world.nation_get_modifier_values(tech_def_nation, sys::national_mod_offsets::military_tactics)));
-					auto org_damage = org_dam_mul *
-							(att_stats.attack_or_gun_power * 0.1f + 1.0f) * attacker_mod /
-							(defender_fort * def_stats.discipline_or_evasion * defender_org_bonus * (1.0f + state.world.nation_get_modifier_values(tech_def_nation, sys::national_mod_offsets::land_organisation)));
-
-					auto& cstr = state.world.regiment_get_strength(att_front_target);
-					str_damage = std::min(str_damage, cstr);
-					state.world.regiment_get_pending_damage(att_front_target) += str_damage;
-					cstr -= str_damage;
-					defender_casualties += str_damage;
-
-					auto& org = state.world.regiment_get_org(att_front_target);
-					org = std::max(0.0f, org - org_damage);
-					switch(state.military_definitions.unit_base_definitions[state.world.regiment_get_type(att_front_target)].type) {
-						case unit_type::infantry:
-							state.world.land_battle_get_defender_infantry_lost(b) += str_damage;
-							break;
-						case unit_type::cavalry:
-							state.world.land_battle_get_defender_cav_lost(b) += str_damage;
-							break;
-						case unit_type::support:
-							// fallthrough
-						case unit_type::special:
-							state.world.land_battle_get_defender_support_lost(b) += str_damage;
-							break;
-						default:
-							break;
-					}
+					add_shot(att_front[i], att_front_target, false, false);
 				}
 			}
 
 			if(def_front[i]) {
 				assert(state.world.regiment_is_valid(def_front[i]));
 
-				auto tech_def_nation = tech_nation_for_regiment(state, def_front[i]);
-				auto& def_stats = state.world.nation_get_unit_stats(tech_def_nation, state.world.regiment_get_type(def_front[i]));
-
 				auto def_front_target = att_front[i];
 
 				if(auto mv = state.military_definitions.unit_base_definitions[state.world.regiment_get_type(def_front[i])].maneuver; !def_front_target && mv > 0.0f) {
@@ -5371,36 +5455,57 @@ void update_land_battles(sys::state& state) {
 
 				if(def_front_target) {
 					assert(state.world.regiment_is_valid(def_front_target));
+					add_shot(def_front[i], def_front_target, true, false);
+				}
+			}
+		}
 
-					auto tech_att_nation = tech_nation_for_regiment(state, def_front_target);
-					auto& att_stats = state.world.nation_get_unit_stats(tech_att_nation, state.world.regiment_get_type(def_front_target));
+		compute_land_combat_damage(lanes);
 
-					auto str_damage = str_dam_mul * (def_stats.attack_or_gun_power * 0.1f + 1.0f) * defender_mod / ((state.defines.base_military_tactics + state.world.nation_get_modifier_values(tech_att_nation, sys::national_mod_offsets::military_tactics)));
-					auto org_damage = org_dam_mul * (def_stats.attack_or_gun_power * 0.1f + 1.0f) * defender_mod / (attacker_org_bonus * def_stats.discipline_or_evasion * (1.0f + state.world.nation_get_modifier_values(tech_att_nation, sys::national_mod_offsets::land_organisation)));
+		for(int32_t k = 0; k < lanes.count; ++k) {
+			auto target = lanes.target[k];
 
-					auto& cstr = state.world.regiment_get_strength(def_front_target);
-					str_damage = std::min(str_damage, cstr);
-					state.world.regiment_get_pending_damage(def_front_target) += str_damage;
-					cstr -= str_damage;
-					attacker_casualties += str_damage;
+			auto& cstr = state.world.regiment_get_strength(target);
+			auto str_damage = std::min(lanes.str_damage[k], cstr);
+			state.world.regiment_get_pending_damage(target) += str_damage;
+			cstr -= str_damage;
 
-					auto& org = state.world.regiment_get_org(def_front_target);
-					org = std::max(0.0f, org - org_damage);
-					switch(state.military_definitions.unit_base_definitions[state.world.regiment_get_type(def_front_target)].type) {
-						case unit_type::infantry:
-							state.world.land_battle_get_attacker_infantry_lost(b) += str_damage;
-							break;
-						case unit_type::cavalry:
-							state.world.land_battle_get_attacker_cav_lost(b) += str_damage;
-							break;
-						case unit_type::support:
-							// fallthrough
-						case unit_type::special:
-							state.world.land_battle_get_attacker_support_lost(b) += str_damage;
-							break;
-						default:
-							break;
-					}
+			auto& org = state.world.regiment_get_org(target);
+			org = std::max(0.0f, org - lanes.org_damage[k]);
+
+			if(lanes.target_is_attacker[k]) {
+				attacker_casualties += str_damage;
+				switch(state.military_definitions.unit_base_definitions[state.world.regiment_get_type(target)].type) {
+					case unit_type::infantry:
+						state.world.land_battle_get_attacker_infantry_lost(b) += str_damage;
+						break;
+					case unit_type::cavalry:
+						state.world.land_battle_get_attacker_cav_lost(b) += str_damage;
+						break;
+					case unit_type::support:
+						// fallthrough
+					case unit_type::special:
+						state.world.land_battle_get_attacker_support_lost(b) += str_damage;
+						break;
+					default:
+						break;
+				}
+			} else {
+				defender_casualties += str_damage;
+				switch(state.military_definitions.unit_base_definitions[state.world.regiment_get_type(target)].type) {
+					case unit_type::infantry:
+						state.world.land_battle_get_defender_infantry_lost(b) += str_damage;
+						break;
+					case unit_type::cavalry:
+						state.world.land_battle_get_defender_cav_lost(b) += str_damage;
+						break;
+					case unit_type::support:
+						// fallthrough
+					case unit_type::special:
+						state.world.land_battle_get_defender_support_lost(b) += str_damage;
+						break;
+					default:
+						break;
 				}
 			}
 		}
@@ -5950,6 +6055,7 @@ void navy_arrives_in_province(sys::state& state, dcon::navy_id n, dcon::province
 	assert(!state.world.navy_get_battle_from_navy_battle_participation(n));
 
 	state.world.navy_set_location_from_navy_location(n, p);
+	note_navy_presence(state, n, p);
 	auto ships = state.world.navy_get_navy_membership(n);
 	if(!state.world.navy_get_is_retreating(n) && p.index() >= state.province_definitions.first_sea_province.index() && ships.begin() != ships.end()) {
 		auto owner_nation = state.world.navy_get_controller_from_navy_control(n);
@@ -6015,12 +6121,59 @@ void navy_arrives_in_province(sys::state& state, dcon::navy_id n, dcon::province
 	}
 }
 
+// What is known about a unit's next step before any unit moves. An arrival never makes another unit arrive on the same
+// day (new arrival times are always in the future), and nothing done while armies arrive changes control, wars, access
+// or where fleets are, so this stays true while the arrivals are carried out one by one.
+struct unit_arrival {
+	dcon::province_id dest; // empty: the unit is not arriving today
+	uint8_t path_bits = 0;
+	bool has_access = false;
+	bool hostile_in_port = false;
+};
+
 void update_movement(sys::state& state) {
-	for(auto a : state.world.in_army) {
-		auto arrival = a.get_arrival_time();
+	// which units arrive today, and where, is worked out in parallel; the arrivals themselves (embarking, battles,
+	// merges) are then carried out serially in id order, as they can affect each other
+	static std::vector<unit_arrival> army_arrivals;
+	army_arrivals.resize(state.world.army_size());
+	concurrency::parallel_for(uint32_t(0), state.world.army_size(), [&](uint32_t i) {
+		dcon::army_id a{ dcon::army_id::value_base_t(i) };
+		auto& r = army_arrivals[i];
+		r = unit_arrival{};
+		if(!state.world.army_is_valid(a))
+			return;
+		auto arrival = state.world.army_get_arrival_time(a);
 		assert(!arrival || arrival >= state.current_date);
-		if(auto path = a.get_path(); arrival == state.current_date) {
-			assert(path.size() > 0);
+		if(arrival != state.current_date)
+			return;
+		auto path = state.world.army_get_path(a);
+		assert(path.size() > 0);
+		r.dest = path.at(path.size() - 1);
+		if(r.dest.index() >= state.province_definitions.first_sea_province.index())
+			return;
+
+		auto from = state.world.army_get_location_from_army_location(a);
+		auto controller = state.world.army_get_controller_from_army_control(a);
+		r.path_bits = state.world.province_adjacency_get_type(state.world.get_province_adjacency_by_province_pair(r.dest, from));
+		r.has_access = province::has_access_to_province(state, controller, r.dest);
+		if((r.path_bits & province::border::non_adjacent_bit) != 0) {
+			for(auto v : state.world.province_get_navy_location(state.world.province_get_port_to(from))) {
+				if(military::are_at_war(state, controller, v.get_navy().get_controller_from_navy_control())) {
+					r.hostile_in_port = true;
+					break;
+				}
+			}
+		}
+	});
+
+	for(uint32_t i = 0; i < uint32_t(army_arrivals.size()); ++i) {
+		auto const& plan = army_arrivals[i];
+		if(!plan.dest || !state.world.army_is_valid(dcon::army_id{ dcon::army_id::value_base_t(i) }))
+			continue;
+		auto a = fatten(state.world, dcon::army_id{ dcon::army_id::value_base_t(i) });
+		auto arrival = a.get_arrival_time();
+		if(auto path = a.get_path(); arrival == state.current_date) { // an earlier arrival may have sent it elsewhere
+			assert(path.size() > 0 && path.at(path.size() - 1) == plan.dest);
 			auto dest = path.at(path.size() - 1);
 			path.pop_back();
 			auto from = state.world.army_get_location_from_army_location(a);
@@ -6030,6 +6183,7 @@ void update_movement(sys::state& state) {
 				auto to_navy = find_embark_target(state, a.get_controller_from_army_control(), dest, a);
 				if(to_navy) {
 					a.set_location_from_army_location(dest);
+					note_army_presence(state, a, dest);
 					a.set_navy_from_army_transport(to_navy);
 					a.set_black_flag(false);
 				} else {
@@ -6037,16 +6191,15 @@ void update_movement(sys::state& state) {
 				}
 			} else { // land province
 				if(a.get_black_flag()) {
-					if(province::has_access_to_province(state, a.get_controller_from_army_control(), dest)) {
+					if(plan.has_access) {
 						a.set_black_flag(false);
 					}
 					army_arrives_in_province(state, a, dest,
-							(state.world.province_adjacency_get_type(state.world.get_province_adjacency_by_province_pair(dest, from)) &
-									province::border::river_crossing_bit) != 0
+							(plan.path_bits & province::border::river_crossing_bit) != 0
 									? military::crossing_type::river
 									: military::crossing_type::none, dcon::land_battle_id{});
 					a.set_navy_from_army_transport(dcon::navy_id{});
-				} else if(province::has_access_to_province(state, a.get_controller_from_army_control(), dest)) {
+				} else if(plan.has_access) {
 					if(auto n = a.get_navy_from_army_transport()) {
 						if(!n.get_battle_from_navy_battle_participation()) {
 							army_arrives_in_province(state, a, dest, military::crossing_type::sea, dcon::land_battle_id{});
@@ -6055,18 +6208,9 @@ void update_movement(sys::state& state) {
 							path.clear();
 						}
 					} else {
-						auto path_bits = state.world.province_adjacency_get_type(state.world.get_province_adjacency_by_province_pair(dest, from));
+						auto path_bits = plan.path_bits;
 						if((path_bits & province::border::non_adjacent_bit) != 0) { // strait crossing
-							auto port = state.world.province_get_port_to(from);
-							bool hostile_in_port = false;
-							auto controller = a.get_controller_from_army_control();
-							for(auto v : state.world.province_get_navy_location(port)) {
-								if(military::are_at_war(state, controller, v.get_navy().get_controller_from_navy_control())) {
-									hostile_in_port = true;
-									break;
-								}
-							}
-							if(!hostile_in_port) {
+							if(!plan.hostile_in_port) {
 								army_arrives_in_province(state, a, dest, military::crossing_type::sea, dcon::land_battle_id{});
 							} else {
 								path.clear();
@@ -6124,18 +6268,41 @@ void update_movement(sys::state& state) {
 		}
 	}
 
-	for(auto n : state.world.in_navy) {
-		auto arrival = n.get_arrival_time();
+	static std::vector<unit_arrival> navy_arrivals;
+	navy_arrivals.resize(state.world.navy_size());
+	concurrency::parallel_for(uint32_t(0), state.world.navy_size(), [&](uint32_t i) {
+		dcon::navy_id n{ dcon::navy_id::value_base_t(i) };
+		auto& r = navy_arrivals[i];
+		r = unit_arrival{};
+		if(!state.world.navy_is_valid(n))
+			return;
+		auto arrival = state.world.navy_get_arrival_time(n);
 		assert(!arrival || arrival >= state.current_date);
+		if(arrival != state.current_date)
+			return;
+		auto path = state.world.navy_get_path(n);
+		assert(path.size() > 0);
+		r.dest = path.at(path.size() - 1);
+		if(r.dest.index() < state.province_definitions.first_sea_province.index())
+			r.has_access = province::has_naval_access_to_province(state, state.world.navy_get_controller_from_navy_control(n), r.dest);
+	});
+
+	for(uint32_t i = 0; i < uint32_t(navy_arrivals.size()); ++i) {
+		auto const& plan = navy_arrivals[i];
+		if(!plan.dest || !state.world.navy_is_valid(dcon::navy_id{ dcon::navy_id::value_base_t(i) }))
+			continue;
+		auto n = fatten(state.world, dcon::navy_id{ dcon::navy_id::value_base_t(i) });
+		auto arrival = n.get_arrival_time();
 		if(auto path = n.get_path(); arrival == state.current_date) {
-			assert(path.size() > 0);
+			assert(path.size() > 0 && path.at(path.size() - 1) == plan.dest);
 			auto dest = path.at(path.size() - 1);
 			path.pop_back();
 
 			if(dest.index() < state.province_definitions.first_sea_province.index()) { // land province
-				if(province::has_naval_access_to_province(state, n.get_controller_from_navy_control(), dest)) {
+				if(plan.has_access) {
 
 					n.set_location_from_navy_location(dest);
+					note_navy_presence(state, n, dest);
 
 					// check for whether there are troops to disembark
 					auto attached = state.world.navy_get_army_transport(n);
@@ -6150,6 +6317,7 @@ void update_movement(sys::state& state) {
 						if(acontroller && !acontroller.get_is_player_controlled()) {
 							auto army_dest = a.get_ai_province();
 							a.set_location_from_army_location(dest);
+							note_army_presence(state, a, dest);
 							if(army_dest && army_dest != dest) {
 								auto apath = province::make_land_path(state, dest, army_dest, acontroller, a);
 								if(apath.size() > 0) {
@@ -6187,6 +6355,7 @@ void update_movement(sys::state& state) {
 				// take embarked units along with
 				for(auto a : state.world.navy_get_army_transport(n)) {
 					a.get_army().set_location_from_army_location(dest);
+					note_army_presence(state, a.get_army(), dest);
 					a.get_army().get_path().clear();
 					a.get_army().set_arrival_time(sys::date{});
 				}
@@ -6367,52 +6536,61 @@ void update_siege_progress(sys::state& state) {
 
 		dcon::army_id first_army;
 
-		for(auto ar : state.world.province_get_army_location(prov)) {
-			// Only stationary, non black flagged regiments with at least 0.001 strength contribute to a siege.
+		// when every army that has been here has the same controller, one check tells whether any of them could siege
+		bool may_be_sieged = state.world.province_get_army_presence(prov) != 0;
+		if(may_be_sieged && !state.world.province_get_army_presence_mixed(prov)) {
+			auto present = state.world.province_get_army_presence_controller(prov);
+			may_be_sieged = !present ? bool(controller) : (!controller || are_at_war(state, controller, present));
+		}
 
-			if(ar.get_army().get_battle_from_army_battle_participation() || ar.get_army().get_black_flag() ||
-					ar.get_army().get_navy_from_army_transport() || ar.get_army().get_arrival_time()) {
+		if(may_be_sieged) {
+			for(auto ar : state.world.province_get_army_location(prov)) {
+				// Only stationary, non black flagged regiments with at least 0.001 strength contribute to a siege.
 
-				// skip -- blackflag or embarked or moving or fighting
-			} else {
-				bool will_siege = false;
+				if(ar.get_army().get_battle_from_army_battle_participation() || ar.get_army().get_black_flag() ||
+						ar.get_army().get_navy_from_army_transport() || ar.get_army().get_arrival_time()) {
 
-				auto army_controller = ar.get_army().get_controller_from_army_control();
-				if(!army_controller) {					 // rebel army
-					will_siege = bool(controller); // siege anything not rebel controlled
+					// skip -- blackflag or embarked or moving or fighting
 				} else {
-					if(!controller) {
-						will_siege = true; // siege anything rebel controlled
-					} else if(are_at_war(state, controller, army_controller)) {
-						will_siege = true;
+					bool will_siege = false;
+
+					auto army_controller = ar.get_army().get_controller_from_army_control();
+					if(!army_controller) {					 // rebel army
+						will_siege = bool(controller); // siege anything not rebel controlled
+					} else {
+						if(!controller) {
+							will_siege = true; // siege anything rebel controlled
+						} else if(are_at_war(state, controller, army_controller)) {
+							will_siege = true;
+						}
 					}
-				}
 
-				if(will_siege) {
-					if(!first_army)
-						first_army = ar.get_army();
+					if(will_siege) {
+						if(!first_army)
+							first_army = ar.get_army();
 
-					auto army_stats = army_controller ? army_controller : ar.get_army().get_army_rebel_control().get_controller().get_ruler_from_rebellion_within();
+						auto army_stats = army_controller ? army_controller : ar.get_army().get_army_rebel_control().get_controller().get_ruler_from_rebellion_within();
 
-					owner_involved = owner_involved || owner == army_controller;
-					core_owner_involved =
-							core_owner_involved || bool(state.world.get_core_by_prov_tag_key(prov,  state.world.nation_get_identity_from_identity_holder(army_controller)));
+						owner_involved = owner_involved || owner == army_controller;
+						core_owner_involved =
+								core_owner_involved || bool(state.world.get_core_by_prov_tag_key(prov,  state.world.nation_get_identity_from_identity_holder(army_controller)));
 
-					for(auto r : ar.get_army().get_army_membership()) {
-						auto reg_str = r.get_regiment().get_strength();
-						if(reg_str > 0.001f) {
-							auto type = r.get_regiment().get_type();
-							auto& stats = state.world.nation_get_unit_stats(army_stats, type);
+						for(auto r : ar.get_army().get_army_membership()) {
+							auto reg_str = r.get_regiment().get_strength();
+							if(reg_str > 0.001f) {
+								auto type = r.get_regiment().get_type();
+								auto& stats = state.world.nation_get_unit_stats(army_stats, type);
 
-							total_sieging_strength += reg_str;
+								total_sieging_strength += reg_str;
 
-							if(stats.siege_or_torpedo_attack > 0.0f) {
-								strength_siege_units += reg_str;
-								max_siege_value = std::max(max_siege_value, stats.siege_or_torpedo_attack);
-							}
-							if(stats.reconnaissance_or_fire_range > 0.0f) {
-								strength_recon_units += reg_str;
-								max_recon_value = std::max(max_recon_value, stats.reconnaissance_or_fire_range);
+								if(stats.siege_or_torpedo_attack > 0.0f) {
+									strength_siege_units += reg_str;
+									max_siege_value = std::max(max_siege_value, stats.siege_or_torpedo_attack);
+								}
+								if(stats.reconnaissance_or_fire_range > 0.0f) {
+									strength_recon_units += reg_str;
+									max_recon_value = std::max(max_recon_value, stats.reconnaissance_or_fire_range);
+								}
 							}
 						}
 					}
@@ -6617,6 +6795,7 @@ void eject_ships(sys::state& state, dcon::province_id p) {
 
 		for(auto a : state.world.navy_get_army_transport(n)) {
 			a.get_army().set_location_from_army_location(sea_zone);
+			note_army_presence(state, a.get_army(), sea_zone);
 			a.get_army().get_path().clear();
 			a.get_army().set_arrival_time(sys::date{});
 		}
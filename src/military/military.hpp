@@ -126,6 +126,33 @@ static_assert(sizeof(unit_definition) ==
 	+ sizeof(unit_definition::type)
 	+ sizeof(unit_definition::padding));
 
+// Packed nation x nation bit matrices for the relationships that pathfinding and movement ask about for every
+// province they look at. These are derived data: rebuilt by restore_unsaved_values and kept current by
+// add_to_war, remove_from_war and give / remove_military_access
+struct relationship_matrix {
+	static constexpr uint32_t max_nations = 2000; // the size of the nation container
+	static constexpr uint32_t words_per_row = (max_nations + 63) / 64;
+
+	std::vector<uint64_t> at_war;          // symmetric: on opposite sides of some war
+	std::vector<uint64_t> allied_in_war;   // symmetric: on the same side of some war
+	std::vector<uint64_t> military_access; // row = the nation moving, column = the nation granting access
+
+	static bool get(std::vector<uint64_t> const& m, dcon::nation_id a, dcon::nation_id b) {
+		if(!a || !b || m.empty())
+			return false;
+		return (m[a.index() * words_per_row + b.index() / 64] & (uint64_t(1) << (b.index() & 63))) != 0;
+	}
+	static void set(std::vector<uint64_t>& m, dcon::nation_id a, dcon::nation_id b, bool v) {
+		if(!a || !b || m.empty()) // not built yet: rebuild_relationship_matrix will pick this up
+			return;
+		auto& word = m[a.index() * words_per_row + b.index() / 64];
+		if(v)
+			word |= (uint64_t(1) << (b.index() & 63));
+		else
+			word &= ~(uint64_t(1) << (b.index() & 63));
+	}
+};
+
 struct global_military_state {
 	tagged_vector<unit_definition, dcon::unit_type_id> unit_base_definitions;
 
@@ -153,6 +180,8 @@ struct global_military_state {
 	dcon::unit_type_id artillery;
 
 	bool pending_blackflag_update = false;
+
+	relationship_matrix relationships;
 };
 
 struct available_cb {
@@ -254,6 +283,10 @@ void reset_unit_stats(sys::state& state);
 void apply_base_unit_stat_modifiers(sys::state& state);
 void restore_unsaved_values(sys::state& state); // must run after determining connectivity
 
+void rebuild_relationship_matrix(sys::state& state);
+void reset_relationships(sys::state& state, dcon::nation_id n); // for when a nation id is deleted and reused
+void validate_relationship_matrix(sys::state const& state);     // debug builds only: compares against the war participants
+
 bool are_at_war(sys::state const& state, dcon::nation_id a, dcon::nation_id b);
 bool are_allied_in_war(sys::state const& state, dcon::nation_id a, dcon::nation_id b);
 bool are_in_common_war(sys::state const& state, dcon::nation_id a, dcon::nation_id b);
@@ -302,6 +335,15 @@ bool province_is_under_siege(sys::state const& state, dcon::province_id ids);
 
 void update_blockade_status(sys::state& state);
 
+/* The unit presence of a province counts the armies and navies that have been placed there since it was last rebuilt,
+   along with their controller (null for rebels), or a mixed flag if not all of them share one. Units leaving don't
+   reduce the counts, so a zero or unmixed entry lets the siege, blockade and battle checks skip the province, and
+   anything else falls back to looking at the units themselves. Every place that gives a unit a new location or
+   controller must call note_army_presence / note_navy_presence */
+void update_unit_presence(sys::state& state);
+void note_army_presence(sys::state& state, dcon::army_id a, dcon::province_id p);
+void note_navy_presence(sys::state& state, dcon::navy_id n, dcon::province_id p);
+
 template<typename T>
 auto battle_is_ongoing_in_province(sys::state const& state, T ids);
 
@@ -436,6 +478,32 @@ void eject_ships(sys::state& state, dcon::province_id p);
 void update_movement(sys::state& state);
 void update_siege_progress(sys::state& state);
 void update_naval_battles(sys::state& state);
+
+/* The damage of one day of a land battle, with one shot per lane. Every kind of shot is written as
+   str = str_dam_mul * power * support * side_mod / (fort * tactics)
+   org = org_dam_mul * power * support * side_mod / (fort * org_first * org_second * org_defense)
+   where the factors that a kind of shot doesn't have are 1.0f, so that the lanes come out exactly as the
+   per-regiment expressions they replace did */
+struct land_combat_lanes {
+	static constexpr int32_t max_lanes = 4 * 30; // four shots per position of the widest possible battle
+	int32_t count = 0;
+
+	float power[max_lanes];
+	float support[max_lanes];
+	float side_mod[max_lanes];
+	float fort[max_lanes];
+	float tactics[max_lanes];
+	float org_first[max_lanes];
+	float org_second[max_lanes];
+	float org_defense[max_lanes];
+
+	float str_damage[max_lanes];
+	float org_damage[max_lanes];
+
+	dcon::regiment_id target[max_lanes];
+	bool target_is_attacker[max_lanes];
+};
+void compute_land_combat_damage(land_combat_lanes& lanes);
 void update_land_battles(sys::state& state);
 void apply_regiment_damage(sys::state& state);
 void apply_attrition(sys::state& state);
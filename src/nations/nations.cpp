@@ -188,6 +188,7 @@ void restore_unsaved_values(sys::state& state) {
 			state.world.nation_set_in_sphere_of(t, gp);
 		}
 	});
+	province::invalidate_land_access(state);
 
 	state.world.execute_serial_over_nation([&](auto ids) {
 		auto treasury = state.world.nation_get_stockpiles(ids, economy::money);
@@ -573,6 +574,7 @@ void update_great_powers(sys::state& state) {
 					rel.get_influence_target().set_in_sphere_of(dcon::nation_id{});
 				state.world.delete_gp_relationship(rel);
 			}
+			province::invalidate_land_access(state, n);
 
 			notification::post(state, notification::message{
 				[n](sys::state& state, text::layout_base& contents) {
@@ -593,6 +595,7 @@ void update_great_powers(sys::state& state) {
 			state.great_nations.push_back(sys::great_nation(state.current_date, n));
 			state.world.nation_set_state_from_flashpoint_focus(n, dcon::state_instance_id{});
 
+			province::invalidate_land_access(state, state.world.nation_get_in_sphere_of(n));
 			state.world.nation_set_in_sphere_of(n, dcon::nation_id{});
 			auto rng = state.world.nation_get_gp_relationship_as_influence_target(n);
 			while(rng.begin() != rng.end()) {
@@ -1322,6 +1325,8 @@ void cleanup_nation(sys::state& state, dcon::nation_id n) {
 
 	state.world.delete_nation(n);
 	auto new_ident_holder = state.world.create_nation();
+	military::reset_relationships(state, n);
+	military::reset_relationships(state, new_ident_holder);
 	state.world.try_create_identity_holder(new_ident_holder, old_ident);
 
 	for(auto o : state.world.in_nation) {
@@ -1346,6 +1351,8 @@ void adjust_prestige(sys::state& state, dcon::nation_id n, float delta) {
 }
 
 void destroy_diplomatic_relationships(sys::state& state, dcon::nation_id n) {
+	province::invalidate_land_access(state, n);
+	province::invalidate_land_access(state, state.world.nation_get_in_sphere_of(n));
 	{
 		auto gp_relationships = state.world.nation_get_gp_relationship_as_great_power(n);
 		while(gp_relationships.begin() != gp_relationships.end()) {
@@ -1393,6 +1400,7 @@ void release_vassal(sys::state& state, dcon::overlord_id rel) {
 		}
 		state.world.nation_get_vassals_count(ol)--;
 		state.world.delete_overlord(rel);
+		province::invalidate_land_access(state, ol);
 		politics::update_displayed_identity(state, vas);
 		// TODO: notify player
 	}
@@ -1417,6 +1425,7 @@ void make_vassal(sys::state& state, dcon::nation_id subject, dcon::nation_id ove
 		}
 	} else {
 		state.world.force_create_overlord(subject, overlord);
+		province::invalidate_land_access(state, overlord);
 		state.world.nation_get_vassals_count(overlord)++;
 		politics::update_displayed_identity(state, subject);
 	}
@@ -1440,6 +1449,7 @@ void make_substate(sys::state& state, dcon::nation_id subject, dcon::nation_id o
 		}
 	} else {
 		state.world.force_create_overlord(subject, overlord);
+		province::invalidate_land_access(state, overlord);
 		state.world.nation_set_is_substate(subject, true);
 		state.world.nation_get_vassals_count(overlord)++;
 		state.world.nation_get_substates_count(current_ruler)++;
@@ -2708,6 +2718,7 @@ void adjust_influence_with_overflow(sys::state& state, dcon::nation_id great_pow
 		if(state.world.nation_get_in_sphere_of(target) == great_power) {
 			inf += state.defines.addtosphere_influence_cost;
 			state.world.nation_set_in_sphere_of(target, dcon::nation_id{});
+			province::invalidate_land_access(state, great_power);
 
 			auto& l = state.world.gp_relationship_get_status(rel);
 			l = nations::influence::decrease_level(l);
@@ -2724,6 +2735,7 @@ void adjust_influence_with_overflow(sys::state& state, dcon::nation_id great_pow
 			inf -= state.defines.removefromsphere_influence_cost;
 			auto affected_gp = state.world.nation_get_in_sphere_of(target);
 			state.world.nation_set_in_sphere_of(target, dcon::nation_id{});
+			province::invalidate_land_access(state, affected_gp);
 			{
 				auto orel = state.world.get_gp_relationship_by_gp_influence_pair(target, affected_gp);
 				auto& l = state.world.gp_relationship_get_status(orel);
@@ -2731,6 +2743,7 @@ void adjust_influence_with_overflow(sys::state& state, dcon::nation_id great_pow
 			}
 		} else if((state.world.gp_relationship_get_status(rel) & influence::level_mask) == influence::level_friendly) {
 			state.world.nation_set_in_sphere_of(target, great_power);
+			province::invalidate_land_access(state, great_power);
 			inf -= state.defines.addtosphere_influence_cost;
 			auto& l = state.world.gp_relationship_get_status(rel);
 			l = nations::influence::increase_level(l);
@@ -15,12 +15,17 @@
 #include <arpa/inet.h>
 #include <stdio.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #endif // ...
 #include "system_state.hpp"
 #include "commands.hpp"
 #include "SPSCQueue.h"
 #include "network.hpp"
 #include "serialization.hpp"
+#include "blake2.h"
 
 #define ZSTD_STATIC_LINKING_ONLY
 #define XXH_NAMESPACE ZSTD_
@@ -51,7 +56,10 @@ static int internal_socket_recv(socket_t socket_fd, void *data, size_t n) {
 		return static_cast<int>(recv(socket_fd, reinterpret_cast<char *>(data), static_cast<int>(n), 0));
 	return 0;
 #else
-	return recv(socket_fd, data, n, MSG_DONTWAIT);
+	auto r = recv(socket_fd, data, n, MSG_DONTWAIT);
+	if(r < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+		return 0; // nothing pending
+	return int(r);
 #endif
 }
 
@@ -300,6 +308,271 @@ static socket_t socket_init_client(struct sockaddr_in6& client_address, const ch
 	return socket_fd;
 }
 
+#ifndef _WIN64
+//
+// network thread (NIX host)
+//
+
+static void socket_set_nonblocking(socket_t socket_fd) {
+	int flags = fcntl(socket_fd, F_GETFL, 0);
+	fcntl(socket_fd, F_SETFL, flags | O_NONBLOCK);
+}
+
+static void io_wakeup(network_state& ns) {
+	uint64_t v = 1;
+	[[maybe_unused]] auto r = write(ns.io_wakeup_fd, &v, sizeof(v));
+}
+
+static void io_push_event(network_state& ns, io_event const& e) {
+	/* Only ever blocks if the game thread has stopped consuming, in which case
+	   there is nothing better for the network thread to do anyways */
+	while(!ns.io_events.try_push(e)) {
+		if(ns.io_quit.load(std::memory_order::acquire))
+			return;
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+}
+
+static void io_update_interest(network_state& ns, uint8_t index) {
+	auto& io = ns.io_clients[index];
+	bool want_write = io.out_offset < io.out_buffer.size();
+	if(want_write == io.want_write)
+		return;
+	io.want_write = want_write;
+	struct epoll_event ev{};
+	ev.events = EPOLLIN | (want_write ? EPOLLOUT : 0);
+	ev.data.u32 = index;
+	epoll_ctl(ns.epoll_fd, EPOLL_CTL_MOD, io.socket_fd, &ev);
+}
+
+static void io_close_client(network_state& ns, uint8_t index, bool notify) {
+	auto& io = ns.io_clients[index];
+	if(io.socket_fd <= 0)
+		return;
+	epoll_ctl(ns.epoll_fd, EPOLL_CTL_DEL, io.socket_fd, nullptr);
+	socket_shutdown(io.socket_fd);
+	if(notify) {
+		io_event e{};
+		e.type = io_event_type::client_disconnected;
+		e.client_index = index;
+		e.generation = io.generation;
+		io_push_event(ns, e);
+	}
+	io.out_buffer.clear();
+	io.out_offset = 0;
+	io.recv_count = 0;
+	io.handshake = true;
+	io.want_write = false;
+	{
+		std::lock_guard lock{ io.send_lock };
+		io.socket_fd = 0;
+		io.pending_send.clear();
+		ns.clients[index].io_pending_bytes.store(0, std::memory_order::release);
+	}
+}
+
+static void io_accept_clients(network_state& ns) {
+	while(true) {
+		uint8_t index = 0;
+		while(index < ns.io_clients.size() && ns.io_clients[index].socket_fd > 0)
+			++index;
+
+		struct sockaddr_in6 v6_address{};
+		struct sockaddr_in v4_address{};
+		socket_t fd = 0;
+		if(ns.as_v6) {
+			socklen_t addr_len = sizeof(v6_address);
+			fd = accept(ns.socket_fd, (struct sockaddr*)&v6_address, &addr_len);
+		} else {
+			socklen_t addr_len = sizeof(v4_address);
+			fd = accept(ns.socket_fd, (struct sockaddr*)&v4_address, &addr_len);
+		}
+		if(fd < 0)
+			return; // EAGAIN: nobody else waiting
+		if(index == ns.io_clients.size()) { // lobby full
+			socket_shutdown(fd);
+			continue;
+		}
+		socket_set_nonblocking(fd);
+
+		auto& io = ns.io_clients[index];
+		{
+			std::lock_guard lock{ io.send_lock };
+			io.socket_fd = fd;
+			io.generation++;
+			io.pending_send.clear();
+		}
+		io.handshake = true;
+		io.recv_count = 0;
+		io.want_write = false;
+
+		struct epoll_event ev{};
+		ev.events = EPOLLIN;
+		ev.data.u32 = index;
+		epoll_ctl(ns.epoll_fd, EPOLL_CTL_ADD, fd, &ev);
+
+		io_event e{};
+		e.type = io_event_type::client_accepted;
+		e.client_index = index;
+		e.generation = io.generation;
+		e.socket_fd = fd;
+		e.v6_address = v6_address;
+		e.v4_address = v4_address;
+		io_push_event(ns, e);
+	}
+}
+
+/* Reads everything available on the socket, decoding as many complete handshakes/commands as
+   possible; returns false if the connection has to be dropped */
+static bool io_receive(network_state& ns, uint8_t index) {
+	auto& io = ns.io_clients[index];
+	while(true) {
+		void* target = io.handshake ? static_cast<void*>(&io.hshake_buffer) : static_cast<void*>(&io.recv_buffer);
+		size_t len = io.handshake ? sizeof(io.hshake_buffer) : sizeof(io.recv_buffer);
+		auto r = recv(io.socket_fd, reinterpret_cast<uint8_t*>(target) + io.recv_count, len - io.recv_count, MSG_DONTWAIT);
+		if(r == 0) // peer closed the connection
+			return false;
+		if(r < 0)
+			return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+		io.recv_count += size_t(r);
+		if(io.recv_count == len) {
+			io.recv_count = 0;
+			io_event e{};
+			e.client_index = index;
+			e.generation = io.generation;
+			if(io.handshake) {
+				e.type = io_event_type::client_handshake;
+				e.hshake = io.hshake_buffer;
+				io.handshake = false;
+			} else {
+				e.type = io_event_type::client_command;
+				e.cmd = io.recv_buffer;
+			}
+			io_push_event(ns, e);
+		}
+	}
+}
+
+/* Writes as much as the socket accepts without blocking; returns false if the connection has to be dropped */
+static bool io_send(network_state& ns, uint8_t index) {
+	auto& io = ns.io_clients[index];
+	auto& client = ns.clients[index];
+	if(io.out_offset == io.out_buffer.size()) {
+		io.out_buffer.clear();
+		io.out_offset = 0;
+		std::lock_guard lock{ io.send_lock };
+		std::swap(io.out_buffer, io.pending_send);
+	} else {
+		std::lock_guard lock{ io.send_lock };
+		if(!io.pending_send.empty()) {
+			io.out_buffer.insert(io.out_buffer.end(), io.pending_send.begin(), io.pending_send.end());
+			io.pending_send.clear();
+		}
+	}
+	while(io.out_offset < io.out_buffer.size()) {
+		auto r = send(io.socket_fd, io.out_buffer.data() + io.out_offset, io.out_buffer.size() - io.out_offset, MSG_NOSIGNAL | MSG_DONTWAIT);
+		if(r < 0) {
+			if(errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+				break;
+			return false;
+		}
+		io.out_offset += size_t(r);
+		client.total_sent_bytes.fetch_add(size_t(r), std::memory_order::acq_rel);
+		client.io_pending_bytes.fetch_sub(size_t(r), std::memory_order::acq_rel);
+	}
+	// Only keep consumed data around while it is cheap to do so
+	if(io.out_offset == io.out_buffer.size()) {
+		io.out_buffer.clear();
+		io.out_offset = 0;
+	} else if(io.out_offset >= io.out_buffer.size() / 2) {
+		io.out_buffer.erase(io.out_buffer.begin(), io.out_buffer.begin() + io.out_offset);
+		io.out_offset = 0;
+	}
+	return true;
+}
+
+static void io_thread_main(network_state& ns) {
+	std::array<struct epoll_event, 32> events;
+	while(!ns.io_quit.load(std::memory_order::acquire)) {
+		int n = epoll_wait(ns.epoll_fd, events.data(), int(events.size()), 100);
+		for(int i = 0; i < n; i++) {
+			auto id = events[i].data.u32;
+			if(id == uint32_t(-1)) { // listening socket
+				io_accept_clients(ns);
+			} else if(id == uint32_t(-2)) { // woken up by the game thread
+				uint64_t v = 0;
+				[[maybe_unused]] auto r = read(ns.io_wakeup_fd, &v, sizeof(v));
+			} else {
+				uint8_t index = uint8_t(id);
+				if(ns.io_clients[index].socket_fd <= 0)
+					continue;
+				bool ok = (events[i].events & (EPOLLERR | EPOLLHUP)) == 0;
+				if(ok && (events[i].events & EPOLLIN) != 0)
+					ok = io_receive(ns, index);
+				if(ok && (events[i].events & EPOLLOUT) != 0)
+					ok = io_send(ns, index);
+				if(!ok)
+					io_close_client(ns, index, true);
+			}
+		}
+		// handle requests of the game thread
+		while(auto* req = ns.io_requests.front()) {
+			auto& io = ns.io_clients[req->client_index];
+			if(req->type == io_request_type::close_client && io.generation == req->generation)
+				io_close_client(ns, req->client_index, false);
+			ns.io_requests.pop();
+		}
+		// flush new data handed over by the game thread, dropping clients that can't keep up
+		for(uint8_t index = 0; index < uint8_t(ns.io_clients.size()); index++) {
+			auto& io = ns.io_clients[index];
+			if(io.socket_fd <= 0)
+				continue;
+			if(ns.clients[index].io_pending_bytes.load(std::memory_order::acquire) > max_client_pending_bytes) {
+				io_close_client(ns, index, true);
+				continue;
+			}
+			if(!io.want_write) {
+				if(!io_send(ns, index)) {
+					io_close_client(ns, index, true);
+					continue;
+				}
+			}
+			io_update_interest(ns, index);
+		}
+	}
+	for(uint8_t index = 0; index < uint8_t(ns.io_clients.size()); index++)
+		io_close_client(ns, index, false);
+}
+
+static void io_thread_start(network_state& ns) {
+	socket_set_nonblocking(ns.socket_fd);
+	ns.epoll_fd = epoll_create1(0);
+	ns.io_wakeup_fd = eventfd(0, EFD_NONBLOCK);
+	if(ns.epoll_fd < 0 || ns.io_wakeup_fd < 0)
+		std::abort();
+	struct epoll_event ev{};
+	ev.events = EPOLLIN;
+	ev.data.u32 = uint32_t(-1);
+	epoll_ctl(ns.epoll_fd, EPOLL_CTL_ADD, ns.socket_fd, &ev);
+	ev.data.u32 = uint32_t(-2);
+	epoll_ctl(ns.epoll_fd, EPOLL_CTL_ADD, ns.io_wakeup_fd, &ev);
+	ns.io_quit.store(false, std::memory_order::release);
+	ns.io_thread = std::thread([&ns]() { io_thread_main(ns); });
+}
+
+static void io_thread_stop(network_state& ns) {
+	if(!ns.io_thread.joinable())
+		return;
+	ns.io_quit.store(true, std::memory_order::release);
+	io_wakeup(ns);
+	ns.io_thread.join();
+	close(ns.io_wakeup_fd);
+	close(ns.epoll_fd);
+	ns.io_wakeup_fd = -1;
+	ns.epoll_fd = -1;
+}
+#endif
+
 //
 // non-platform specific
 //
@@ -339,6 +612,11 @@ void init(sys::state& state) {
 			state.network_state.socket_fd = socket_init_client(state.network_state.v4_address, state.network_state.ip_address.c_str());
 		}
 	}
+#ifndef _WIN64
+	if(state.network_mode == sys::network_mode_type::host) {
+		io_thread_start(state.network_state);
+	}
+#endif
 
 	// Host must have an already selected nation, to prevent issues...
 	if(state.network_mode == sys::network_mode_type::host) {
@@ -354,38 +632,116 @@ void init(sys::state& state) {
 	}
 }
 
+static void close_client_socket(sys::state& state, client_data& client) {
+#ifndef _WIN64
+	/* The network thread owns the socket, ask it to close it (unless it has been reused by someone else already) */
+	if(client.is_active()) {
+		io_request req{};
+		req.type = io_request_type::close_client;
+		req.client_index = uint8_t(&client - state.network_state.clients.data());
+		req.generation = client.io_generation;
+		state.network_state.io_requests.push(req);
+		io_wakeup(state.network_state);
+	}
+#else
+	socket_shutdown(client.socket_fd);
+#endif
+}
+
 static void disconnect_client(sys::state& state, client_data& client) {
 	command::notify_player_leaves(state, client.playing_as);
-	socket_shutdown(client.socket_fd);
+	close_client_socket(state, client);
 	client.socket_fd = 0;
 	client.send_buffer.clear();
 	client.total_sent_bytes = 0;
+#ifndef _WIN64
+	client.total_queued_bytes = 0;
+#endif
 	client.save_stream_size = 0;
 	client.save_stream_offset = 0;
+	client.save_slots.clear();
 	client.playing_as = dcon::nation_id{};
 	client.recv_count = 0;
 	client.handshake = true;
 }
 
-static uint8_t* write_network_compressed_section(uint8_t* ptr_out, uint8_t const* ptr_in, uint32_t uncompressed_size) {
-	uint32_t decompressed_length = uncompressed_size;
-	uint32_t section_length = uint32_t(ZSTD_compress(ptr_out + sizeof(uint32_t) * 2, ZSTD_compressBound(uncompressed_size), ptr_in,
-		uncompressed_size, ZSTD_maxCLevel())); // write compressed data
-	memcpy(ptr_out, &section_length, sizeof(uint32_t));
-	memcpy(ptr_out + sizeof(uint32_t), &decompressed_length, sizeof(uint32_t));
-	return ptr_out + sizeof(uint32_t) * 2 + section_length;
+/* Loads the save section of the scenario file we are playing, which both the host and the clients
+   have (as they share the same scenario checksum), so that it can be used as a reference for deltas */
+static bool load_save_reference(sys::state& state) {
+	auto& ns = state.network_state;
+	if(!ns.save_reference.empty() && ns.save_reference_scenario.is_equal(state.scenario_checksum))
+		return true;
+	ns.save_reference.clear();
+	if(!sys::try_read_scenario_save_section(state, state.loaded_scenario_file, ns.save_reference)) {
+		ns.save_reference.clear();
+		return false;
+	}
+	ns.save_reference_scenario = state.scenario_checksum;
+	blake2b(&ns.save_reference_checksum, sizeof(ns.save_reference_checksum), ns.save_reference.data(), ns.save_reference.size(), nullptr, 0);
+	return true;
+}
+
+static int network_save_window_log(size_t size) {
+	int window_log = ZSTD_WINDOWLOG_MIN;
+	while(window_log < ZSTD_WINDOWLOG_MAX && (size_t(1) << window_log) < size)
+		++window_log;
+	return window_log;
+}
+
+static uint32_t write_network_compressed_save(network_state& ns, std::unique_ptr<uint8_t[]>& buffer, uint8_t const* ptr_in, uint32_t uncompressed_size, bool as_delta) {
+	network_save_header header;
+	header.decompressed_length = uncompressed_size;
+	// this is an upper bound, since compacting the data may require less space
+	size_t bound = ZSTD_compressBound(uncompressed_size);
+	buffer = std::unique_ptr<uint8_t[]>(new uint8_t[sizeof(header) + bound]);
+
+	auto cctx = ZSTD_createCCtx();
+	ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, network_save_compression_level);
+	if(as_delta) {
+		/* "patch-from" mode: the whole reference has to fit in the window to be matched against */
+		header.reference_length = uint32_t(ns.save_reference.size());
+		header.reference_checksum = ns.save_reference_checksum;
+		ZSTD_CCtx_setParameter(cctx, ZSTD_c_enableLongDistanceMatching, 1);
+		ZSTD_CCtx_setParameter(cctx, ZSTD_c_windowLog, network_save_window_log(ns.save_reference.size() + uncompressed_size));
+		ZSTD_CCtx_refPrefix(cctx, ns.save_reference.data(), ns.save_reference.size());
+	}
+	size_t r = ZSTD_compress2(cctx, buffer.get() + sizeof(header), bound, ptr_in, uncompressed_size);
+	ZSTD_freeCCtx(cctx);
+	if(ZSTD_isError(r))
+		std::abort();
+
+	header.compressed_length = uint32_t(r);
+	memcpy(buffer.get(), &header, sizeof(header));
+	return uint32_t(sizeof(header) + r);
 }
 
 template<typename T>
-static uint8_t const* with_network_decompressed_section(uint8_t const* ptr_in, T const& function) {
-	uint32_t section_length = 0;
-	uint32_t decompressed_length = 0;
-	memcpy(&section_length, ptr_in, sizeof(uint32_t));
-	memcpy(&decompressed_length, ptr_in + sizeof(uint32_t), sizeof(uint32_t));
-	auto temp_buffer = std::unique_ptr<uint8_t[]>(new uint8_t[decompressed_length]);
-	ZSTD_decompress(temp_buffer.get(), decompressed_length, ptr_in + sizeof(uint32_t) * 2, section_length);
-	function(temp_buffer.get(), decompressed_length);
-	return ptr_in + sizeof(uint32_t) * 2 + section_length;
+static void with_network_decompressed_save(sys::state& state, uint8_t const* ptr_in, T const& function) {
+	auto& ns = state.network_state;
+	network_save_header header;
+	memcpy(&header, ptr_in, sizeof(header));
+	auto temp_buffer = std::unique_ptr<uint8_t[]>(new uint8_t[header.decompressed_length]);
+
+	auto dctx = ZSTD_createDCtx();
+	if(header.reference_length > 0) {
+		if(!load_save_reference(state) || ns.save_reference.size() != header.reference_length || !ns.save_reference_checksum.is_equal(header.reference_checksum)) {
+#ifdef _WIN64
+			MessageBoxA(NULL, "The save sent by the host was made against a different copy of the scenario file! Ask the host for their scenario file.", "Network error", MB_OK);
+#endif
+			std::abort();
+		}
+		ZSTD_DCtx_setParameter(dctx, ZSTD_d_windowLogMax, ZSTD_WINDOWLOG_MAX);
+		ZSTD_DCtx_refPrefix(dctx, ns.save_reference.data(), ns.save_reference.size());
+	}
+	size_t r = ZSTD_decompressDCtx(dctx, temp_buffer.get(), header.decompressed_length, ptr_in + sizeof(header), header.compressed_length);
+	ZSTD_freeDCtx(dctx);
+	if(ZSTD_isError(r)) {
+#ifdef _WIN64
+		MessageBoxA(NULL, "Network client save stream could not be decompressed", "Network error", MB_OK);
+#endif
+		std::abort();
+	}
+	function(temp_buffer.get(), header.decompressed_length);
 }
 
 bool client_data::is_banned(sys::state& state) const {
@@ -400,47 +756,56 @@ bool client_data::is_banned(sys::state& state) const {
 	}
 }
 
+static void on_client_handshake(sys::state& state, client_data& client, client_handshake_data const& hshake) {
+	if(std::memcmp(hshake.password, state.network_state.password, sizeof(state.network_state.password))) {
+		disconnect_client(state, client);
+		return;
+	}
+	{ /* Tell everyone else (ourselves + this client) that this client, in fact, has joined */
+		command::payload c;
+		memset(&c, 0, sizeof(c));
+		c.type = command::command_type::notify_player_joins;
+		c.source = client.playing_as;
+		c.data.player_name = hshake.nickname;
+		broadcast_to_clients(state, c);
+		command::execute_command(state, c);
+	}
+	client.handshake = false; /* Exit from handshake mode */
+	state.game_state_updated.store(true, std::memory_order::release);
+}
+
+static void on_client_command(sys::state& state, client_data& client, command::payload const& cmd) {
+	switch(cmd.type) {
+	case command::command_type::invalid:
+	case command::command_type::notify_player_ban:
+	case command::command_type::notify_player_kick:
+	case command::command_type::notify_save_loaded:
+	case command::command_type::advance_tick:
+	case command::command_type::notify_start_game:
+	case command::command_type::notify_stop_game:
+	case command::command_type::notify_pause_game:
+		break; // has to be valid/sendable by client
+	default:
+		/* Has to be from the nation of the client proper */
+		if(cmd.source == client.playing_as) {
+			state.network_state.outgoing_commands.push(cmd);
+		}
+		break;
+	}
+}
+
+#ifdef _WIN64
 static void receive_from_clients(sys::state& state) {
 	for(auto& client : state.network_state.clients) {
 		if(client.is_active()) {
 			int r = 0;
 			if(client.handshake) {
 				r = socket_recv(client.socket_fd, &client.hshake_buffer, sizeof(client.hshake_buffer), &client.recv_count, [&]() {
-					if(std::memcmp(client.hshake_buffer.password, state.network_state.password, sizeof(state.network_state.password))) {
-						disconnect_client(state, client);
-						return;
-					}
-					{ /* Tell everyone else (ourselves + this client) that this client, in fact, has joined */
-						command::payload c;
-						memset(&c, 0, sizeof(c));
-						c.type = command::command_type::notify_player_joins;
-						c.source = client.playing_as;
-						c.data.player_name = client.hshake_buffer.nickname;
-						broadcast_to_clients(state, c);
-						command::execute_command(state, c);
-					}
-					client.handshake = false; /* Exit from handshake mode */
-					state.game_state_updated.store(true, std::memory_order::release);
+					on_client_handshake(state, client, client.hshake_buffer);
 				});
 			} else {
 				r = socket_recv(client.socket_fd, &client.recv_buffer, sizeof(client.recv_buffer), &client.recv_count, [&]() {
-					switch(client.recv_buffer.type) {
-					case command::command_type::invalid:
-					case command::command_type::notify_player_ban:
-					case command::command_type::notify_player_kick:
-					case command::command_type::notify_save_loaded:
-					case command::command_type::advance_tick:
-					case command::command_type::notify_start_game:
-					case command::command_type::notify_stop_game:
-					case command::command_type::notify_pause_game:
-						break; // has to be valid/sendable by client
-					default:
-						/* Has to be from the nation of the client proper */
-						if(client.recv_buffer.source == client.playing_as) {
-							state.network_state.outgoing_commands.push(client.recv_buffer);
-						}
-						break;
-					}
+					on_client_command(state, client, client.recv_buffer);
 				});
 			}
 			if(r < 0) // error
@@ -448,39 +813,97 @@ static void receive_from_clients(sys::state& state) {
 		}
 	}
 }
+#endif
 
-uint32_t write_network_save(sys::state& state, std::unique_ptr<uint8_t[]>& buffer) {
+void write_network_save(sys::state& state) {
 	/* A save lock will be set when we load a save, naturally loading a save implies
 	that we have done preload/fill_unsaved so we will skip doing that again, to save a
 	bit of sanity on our miserable CPU */
+	auto& ns = state.network_state;
+	clear_network_save(state);
+
+	/* Serializing has to be done right now, but compressing can be done while the
+	host carries on, clients that need the save will get it once it is ready */
 	size_t length = sizeof_save_section(state);
 	auto save_buffer = std::unique_ptr<uint8_t[]>(new uint8_t[length]);
 	write_save_section(save_buffer.get(), state);
-	// this is an upper bound, since compacting the data may require less space
-	buffer = std::unique_ptr<uint8_t[]>(new uint8_t[ZSTD_compressBound(length) + sizeof(uint32_t) * 2]);
-	auto buffer_position = write_network_compressed_section(buffer.get(), save_buffer.get(), uint32_t(length));
-	return uint32_t(buffer_position - buffer.get());
+	bool as_delta = load_save_reference(state);
+
+	ns.save_compressed.store(false, std::memory_order::release);
+	ns.save_compressor = std::thread([&ns, save_buffer = std::move(save_buffer), length, as_delta]() {
+		ns.current_save_length = write_network_compressed_save(ns, ns.current_save_buffer, save_buffer.get(), uint32_t(length), as_delta);
+		ns.save_compressed.store(true, std::memory_order::release);
+	});
 }
 
-void broadcast_save_to_clients(sys::state& state, command::payload& c, uint8_t const* buffer, uint32_t length) {
+/* Puts the compressed save into the client's send buffer at position, right after the notify_save_loaded
+   command that announces it */
+static void write_save_into_send_buffer(sys::state& state, client_data& client, size_t position) {
+	uint32_t length = state.network_state.current_save_length;
+#ifndef _WIN64
+	client.save_stream_offset = client.total_queued_bytes + position;
+#else
+	client.save_stream_offset = client.total_sent_bytes + position;
+#endif
+	client.save_stream_size = size_t(length);
+	auto const* length_bytes = reinterpret_cast<char const*>(&length);
+	auto const* save_bytes = reinterpret_cast<char const*>(state.network_state.current_save_buffer.get());
+	client.send_buffer.insert(client.send_buffer.begin() + position, save_bytes, save_bytes + length);
+	client.send_buffer.insert(client.send_buffer.begin() + position, length_bytes, length_bytes + sizeof(length));
+}
+
+/* Fills the slots that were left for the save while it was being compressed, which lets the clients
+   receive again; everything queued after a slot keeps coming after the save */
+static void fill_save_slots(sys::state& state) {
+	for(auto& client : state.network_state.clients) {
+		size_t shift = 0;
+		for(auto position : client.save_slots) {
+			write_save_into_send_buffer(state, client, position + shift);
+			shift += sizeof(uint32_t) + size_t(state.network_state.current_save_length);
+		}
+		client.save_slots.clear();
+	}
+}
+
+void clear_network_save(sys::state& state) {
+	auto& ns = state.network_state;
+	if(ns.save_compressor.joinable())
+		ns.save_compressor.join();
+	fill_save_slots(state);
+	ns.current_save_buffer.reset();
+	ns.current_save_length = 0;
+}
+
+void broadcast_save_to_clients(sys::state& state, command::payload& c) {
 	/* We need to regenerate the checksum of the save so it's at this specific point */
 	c.data.notify_save_loaded.checksum = state.get_save_checksum();
+	bool compressed = state.network_state.save_compressed.load(std::memory_order::acquire);
 	for(auto& client : state.network_state.clients) {
 		if(client.is_active()) {
 			bool send_full = (client.playing_as == c.data.notify_save_loaded.target) || (!c.data.notify_save_loaded.target);
 			if(send_full && !state.network_state.is_new_game) {
 				/* And then we have to first send the command payload itself */
 				socket_add_to_send_queue(client.send_buffer, &c, sizeof(c));
-				/* And then the bulk payload! */
-				client.save_stream_offset = client.total_sent_bytes + client.send_buffer.size();
-				client.save_stream_size = size_t(length);
-				socket_add_to_send_queue(client.send_buffer, &length, sizeof(length));
-				socket_add_to_send_queue(client.send_buffer, buffer, size_t(length));
+				/* And then the bulk payload, or a place for it if it is still being compressed */
+				if(compressed)
+					write_save_into_send_buffer(state, client, client.send_buffer.size());
+				else
+					client.save_slots.push_back(client.send_buffer.size());
 			}
 		}
 	}
 }
 
+/* Sends the saves that were waiting on the compression to finish */
+static void send_pending_saves(sys::state& state) {
+	auto& ns = state.network_state;
+	if(!ns.save_compressed.load(std::memory_order::acquire))
+		return;
+	if(ns.save_compressor.joinable())
+		ns.save_compressor.join();
+	fill_save_slots(state);
+}
+
 void broadcast_to_clients(sys::state& state, command::payload& c) {
 	if(c.type == command::command_type::save_game)
 		return;
@@ -493,6 +916,48 @@ void broadcast_to_clients(sys::state& state, command::payload& c) {
 	}
 }
 
+static void on_client_accepted(sys::state& state, client_data& client) {
+	if(client.is_banned(state)) {
+		disconnect_client(state, client);
+		return;
+	}
+	/* Do not allow players to join mid-session, they have to go back to the lobby */
+	if(state.mode == sys::game_mode_type::in_game || state.mode == sys::game_mode_type::select_states) {
+		disconnect_client(state, client);
+		return;
+	}
+	/* Send it data so she is in sync with everyone else! */
+	client.playing_as = get_temp_nation(state);
+	assert(client.playing_as);
+	{ /* Tell the client their assigned nation */
+		server_handshake_data hshake;
+		hshake.seed = state.game_seed;
+		hshake.assigned_nation = client.playing_as;
+		hshake.scenario_checksum = state.scenario_checksum;
+		hshake.save_checksum = state.get_save_checksum();
+		socket_add_to_send_queue(client.send_buffer, &hshake, sizeof(hshake));
+	}
+	if(!state.network_state.is_new_game) {
+		command::payload c;
+		memset(&c, 0, sizeof(command::payload));
+		c.type = command::command_type::notify_save_loaded;
+		c.source = state.local_player_nation;
+		c.data.notify_save_loaded.target = client.playing_as;
+		network::broadcast_save_to_clients(state, c);
+	}
+	for(const auto n : state.world.in_nation) {
+		if(n.get_is_player_controlled()) {
+			command::payload c;
+			memset(&c, 0, sizeof(c));
+			c.type = command::command_type::notify_player_joins;
+			c.source = n;
+			c.data.player_name = state.network_state.map_of_player_names[n.id.index()];
+			socket_add_to_send_queue(client.send_buffer, &c, sizeof(c));
+		}
+	}
+}
+
+#ifdef _WIN64
 static void accept_new_clients(sys::state& state) {
 	/* Check if any new clients are to join us */
 	fd_set rfds;
@@ -514,50 +979,146 @@ static void accept_new_clients(sys::state& state) {
 				socklen_t addr_len = sizeof(client.v4_address);
 				client.socket_fd = accept(state.network_state.socket_fd, (struct sockaddr*)&client.v4_address, &addr_len);
 			}
-			if(client.is_banned(state)) {
+			on_client_accepted(state, client);
+			return;
+		}
+	}
+}
+
+static void send_to_clients(sys::state& state) {
+	for(auto& client : state.network_state.clients) {
+		if(client.is_active() && client.save_slots.empty()) {
+			size_t old_size = client.send_buffer.size();
+			if(socket_send(client.socket_fd, client.send_buffer) < 0) { // error
 				disconnect_client(state, client);
-				break;
 			}
-			/* Do not allow players to join mid-session, they have to go back to the lobby */
-			if(state.mode == sys::game_mode_type::in_game || state.mode == sys::game_mode_type::select_states) {
+			client.total_sent_bytes += old_size - client.send_buffer.size();
+		}
+	}
+}
+#else
+/* Consumes what the network thread has received/accepted since the last call */
+static void receive_from_io_thread(sys::state& state) {
+	auto& ns = state.network_state;
+	while(auto* e = ns.io_events.front()) {
+		auto& client = ns.clients[e->client_index];
+		if(e->type == io_event_type::client_accepted) {
+			client.socket_fd = e->socket_fd;
+			client.v6_address = e->v6_address;
+			client.v4_address = e->v4_address;
+			client.total_sent_bytes.store(0, std::memory_order::release);
+			client.io_generation = e->generation;
+			client.handshake = true;
+			client.send_buffer.clear();
+			client.total_queued_bytes = 0;
+			client.save_stream_offset = 0;
+			client.save_stream_size = 0;
+			client.save_slots.clear();
+			on_client_accepted(state, client);
+		} else if(client.is_active() && client.io_generation == e->generation) {
+			switch(e->type) {
+			case io_event_type::client_handshake:
+				on_client_handshake(state, client, e->hshake);
+				break;
+			case io_event_type::client_command:
+				if(!client.handshake)
+					on_client_command(state, client, e->cmd);
+				break;
+			case io_event_type::client_disconnected:
 				disconnect_client(state, client);
 				break;
+			default:
+				break;
 			}
-			/* Send it data so she is in sync with everyone else! */
-			client.playing_as = get_temp_nation(state);
-			assert(client.playing_as);
-			{ /* Tell the client their assigned nation */
-				server_handshake_data hshake;
-				hshake.seed = state.game_seed;
-				hshake.assigned_nation = client.playing_as;
-				hshake.scenario_checksum = state.scenario_checksum;
-				hshake.save_checksum = state.get_save_checksum();
-				socket_add_to_send_queue(client.send_buffer, &hshake, sizeof(hshake));
-			}
-			if(!state.network_state.is_new_game) {
-				command::payload c;
-				memset(&c, 0, sizeof(command::payload));
-				c.type = command::command_type::notify_save_loaded;
-				c.source = state.local_player_nation;
-				c.data.notify_save_loaded.target = client.playing_as;
-				network::broadcast_save_to_clients(state, c, state.network_state.current_save_buffer.get(), state.network_state.current_save_length);
-			}
-			for(const auto n : state.world.in_nation) {
-				if(n.get_is_player_controlled()) {
-					command::payload c;
-					memset(&c, 0, sizeof(c));
-					c.type = command::command_type::notify_player_joins;
-					c.source = n;
-					c.data.player_name = state.network_state.map_of_player_names[n.id.index()];
-					socket_add_to_send_queue(client.send_buffer, &c, sizeof(c));
-				}
+		}
+		ns.io_events.pop();
+	}
+}
+
+/* Hands the data queued during this tick over to the network thread, never blocks on the sockets */
+static void send_to_clients(sys::state& state) {
+	auto& ns = state.network_state;
+	bool has_data = false;
+	for(size_t i = 0; i < ns.clients.size(); i++) {
+		auto& client = ns.clients[i];
+		if(!client.is_active() || client.send_buffer.empty() || !client.save_slots.empty())
+			continue;
+		auto& io = ns.io_clients[i];
+		{
+			std::lock_guard lock{ io.send_lock };
+			if(io.socket_fd > 0 && io.generation == client.io_generation) {
+				client.io_pending_bytes.fetch_add(client.send_buffer.size(), std::memory_order::acq_rel);
+				io.pending_send.insert(io.pending_send.end(), client.send_buffer.begin(), client.send_buffer.end());
 			}
-			return;
 		}
+		client.total_queued_bytes += client.send_buffer.size();
+		client.send_buffer.clear();
+		has_data = true;
+	}
+	if(has_data)
+		io_wakeup(ns);
+}
+#endif
+
+bool frame_needs_checksum(sys::state& state, sys::date from, sys::date to) {
+#ifndef NDEBUG //Debug - daily oos check
+	return from != to;
+#else //Release - monthly oos check
+	for(auto d = from + 1; d <= to; d += 1) {
+		if(d.to_ymd(state.start_date).day == 1)
+			return true;
+	}
+	return false;
+#endif
+}
+
+void record_tick_checksum(sys::state& state, sys::date date, sys::checksum_key const& checksum) {
+	auto& ns = state.network_state;
+	ns.tick_checksums[ns.tick_checksum_count % ns.tick_checksums.size()] = tick_checksum{ checksum, date };
+	ns.tick_checksum_count++;
+}
+
+/* Announces the ticks the host has run since the last frame; clients will run up to the same date,
+   so this has to go out before any input that was executed after those ticks */
+static void send_lockstep_frame(sys::state& state, bool force) {
+	auto& ns = state.network_state;
+	if(ns.last_frame_date == state.current_date)
+		return;
+	auto now = std::chrono::steady_clock::now();
+	if(!force && now - ns.last_frame_time < lockstep_frame_interval)
+		return;
+
+	command::payload c;
+	memset(&c, 0, sizeof(c));
+	c.type = command::command_type::advance_tick;
+	c.source = state.local_player_nation;
+	c.tick = state.current_date;
+	c.has_tick = true;
+	c.data.advance_tick.date = state.current_date;
+	c.data.advance_tick.speed = state.actual_game_speed.load(std::memory_order::acquire);
+	if(frame_needs_checksum(state, ns.last_frame_date, state.current_date)) {
+		c.data.advance_tick.checksum = state.get_save_checksum();
+		record_tick_checksum(state, state.current_date, c.data.advance_tick.checksum);
+	}
+	broadcast_to_clients(state, c);
+	ns.last_frame_date = state.current_date;
+	ns.last_frame_time = now;
+}
+
+/* Inputs are stamped with the date the host executed them on, by then the client
+   must have reached the same date through the preceding frames */
+static void execute_lockstep_input(sys::state& state, command::payload& c) {
+	if(state.mode == sys::game_mode_type::in_game && c.type != command::command_type::advance_tick && c.has_tick) {
+		while(state.current_date < c.tick && state.mode != sys::game_mode_type::end_screen) {
+			state.single_game_tick();
+		}
+		if(state.current_date != c.tick)
+			state.network_state.out_of_sync = true;
 	}
+	command::execute_command(state, c);
 }
 
-void send_and_receive_commands(sys::state& state) {
+bool send_and_receive_commands(sys::state& state) {
 	/* An issue that arose in multiplayer is that the UI was loading the savefile
 	   directly, while the game state loop was running, this was fine with the
 	   assumption that commands weren't executed while the save was being loaded
@@ -566,26 +1127,23 @@ void send_and_receive_commands(sys::state& state) {
 	   This way, we're able to effectively and safely queue commands until we
 	   can receive them AFTER loading the savefile. */
 	if(state.network_state.save_slock.load(std::memory_order::acquire) == true)
-		return;
+		return false;
 
 	bool command_executed = false;
 	if(state.network_mode == sys::network_mode_type::host) {
+#ifdef _WIN64
 		accept_new_clients(state); // accept new connections
 		receive_from_clients(state); // receive new commands
+#else
+		receive_from_io_thread(state); // new connections, commands and disconnections
+#endif
 		// send the commands of the server to all the clients
 		auto* c = state.network_state.outgoing_commands.front();
 		while(c) {
 			if(!command::is_console_command(c->type)) {
-				// Generate checksum on the spot
-				if(c->type == command::command_type::advance_tick) {
-#ifndef NDEBUG //Debug - daily oos check
-					c->data.advance_tick.checksum = state.get_save_checksum();
-#else //Release - monthly oos check
-					if(state.current_date.to_ymd(state.start_date).day == 1) {
-						c->data.advance_tick.checksum = state.get_save_checksum();
-					}
-#endif
-				}
+				send_lockstep_frame(state, true);
+				c->tick = state.current_date;
+				c->has_tick = true;
 				broadcast_to_clients(state, *c);
 				command::execute_command(state, *c);
 				command_executed = true;
@@ -593,16 +1151,9 @@ void send_and_receive_commands(sys::state& state) {
 			state.network_state.outgoing_commands.pop();
 			c = state.network_state.outgoing_commands.front();
 		}
-
-		for(auto& client : state.network_state.clients) {
-			if(client.is_active()) {
-				size_t old_size = client.send_buffer.size();
-				if(socket_send(client.socket_fd, client.send_buffer) < 0) { // error
-					disconnect_client(state, client);
-				}
-				client.total_sent_bytes += old_size - client.send_buffer.size();
-			}
-		}
+		send_lockstep_frame(state, false);
+		send_pending_saves(state);
+		send_to_clients(state);
 	} else if(state.network_mode == sys::network_mode_type::client) {
 		if(state.network_state.handshake) {
 			/* Send our client's handshake */
@@ -674,7 +1225,7 @@ void send_and_receive_commands(sys::state& state) {
 							players.push_back(n);
 					dcon::nation_id old_local_player_nation = state.local_player_nation;
 					state.preload();
-					with_network_decompressed_section(state.network_state.save_data.data(), [&state](uint8_t const* ptr_in, uint32_t length) {
+					with_network_decompressed_save(state, state.network_state.save_data.data(), [&state](uint8_t const* ptr_in, uint32_t length) {
 						read_save_section(ptr_in, ptr_in + length, state);
 					});
 					assert(state.local_player_nation == dcon::nation_id{});
@@ -700,21 +1251,27 @@ void send_and_receive_commands(sys::state& state) {
 				std::abort();
 			}
 		} else {
-			// receive commands from the server and immediately execute them
-			int r = socket_recv(state.network_state.socket_fd, &state.network_state.recv_buffer, sizeof(state.network_state.recv_buffer), &state.network_state.recv_count, [&]() {
-				command::execute_command(state, state.network_state.recv_buffer);
-				command_executed = true;
-				// start save stream!
-				if(state.network_state.recv_buffer.type == command::command_type::notify_save_loaded) {
-					state.network_state.save_size = 0;
-					state.network_state.save_stream = true;
-				}
-			});
-			if(r < 0) { // error
+			// receive commands from the server and immediately execute them, everything that has arrived
+			// gets executed so that a backlog of lockstep frames is caught up on without waiting
+			bool received = true;
+			while(received && !state.network_state.save_stream) {
+				received = false;
+				int r = socket_recv(state.network_state.socket_fd, &state.network_state.recv_buffer, sizeof(state.network_state.recv_buffer), &state.network_state.recv_count, [&]() {
+					execute_lockstep_input(state, state.network_state.recv_buffer);
+					command_executed = true;
+					received = true;
+					// start save stream!
+					if(state.network_state.recv_buffer.type == command::command_type::notify_save_loaded) {
+						state.network_state.save_size = 0;
+						state.network_state.save_stream = true;
+					}
+				});
+				if(r < 0) { // error
 #ifdef _WIN64
-				MessageBoxA(NULL, ("Network client command receive error: " + get_wsa_error_text(WSAGetLastError())).c_str(), "Network error", MB_OK);
+					MessageBoxA(NULL, ("Network client command receive error: " + get_wsa_error_text(WSAGetLastError())).c_str(), "Network error", MB_OK);
 #endif
-				std::abort();
+					std::abort();
+				}
 			}
 			// send the outgoing commands to the server and flush the entire queue
 			auto* c = state.network_state.outgoing_commands.front();
@@ -747,12 +1304,18 @@ void send_and_receive_commands(sys::state& state) {
 		}
 		state.game_state_updated.store(true, std::memory_order::release);
 	}
+	return command_executed;
 }
 
 void finish(sys::state& state) {
 	if(state.network_mode == sys::network_mode_type::single_player)
 		return; // Do nothing in singleplayer
 	
+#ifndef _WIN64
+	io_thread_stop(state.network_state);
+#endif
+	if(state.network_state.save_compressor.joinable())
+		state.network_state.save_compressor.join();
 	socket_shutdown(state.network_state.socket_fd);
 #ifdef _WIN64
 	WSACleanup();
@@ -761,7 +1324,7 @@ void finish(sys::state& state) {
 
 void ban_player(sys::state& state, client_data& client) {
 	if(client.is_active()) {
-		socket_shutdown(client.socket_fd);
+		close_client_socket(state, client);
 		client.socket_fd = 0;
 		if(state.network_state.as_v6) {
 			state.network_state.v6_banlist.push_back(client.v6_address.sin6_addr);
@@ -773,7 +1336,7 @@ void ban_player(sys::state& state, client_data& client) {
 
 void kick_player(sys::state& state, client_data& client) {
 	if(client.is_active()) {
-		socket_shutdown(client.socket_fd);
+		close_client_socket(state, client);
 		client.socket_fd = 0;
 	}
 }
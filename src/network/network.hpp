@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <chrono>
 #include <string>
 #ifdef _WIN64 // WINDOWS
 #define _WINSOCK_DEPRECATED_NO_WARNINGS 1
@@ -12,7 +13,9 @@
 #else // NIX
 #include <netinet/in.h>
 #include <sys/socket.h>
+#include <mutex>
 #endif
+#include <thread>
 #include "SPSCQueue.h"
 #include "container_types.hpp"
 
@@ -23,6 +26,12 @@ struct state;
 namespace network {
 
 inline constexpr short default_server_port = 1984;
+// A client whose unsent data grows past this is considered too slow to keep up and is dropped
+inline constexpr size_t max_client_pending_bytes = 64 * 1024 * 1024;
+// Saves streamed to joining clients are deltas against the scenario, so a fast level is good enough
+inline constexpr int network_save_compression_level = 3;
+// The host batches the ticks it runs into lockstep frames sent at most this often (unless an input needs to go out)
+inline constexpr std::chrono::milliseconds lockstep_frame_interval{ 50 };
 
 #ifdef _WIN64
 typedef SOCKET socket_t;
@@ -44,6 +53,22 @@ struct server_handshake_data {
 	uint8_t reserved[64] = {0};
 };
 
+/* Header of a save streamed to the clients, followed by the compressed data. When reference_length is
+   non-zero the save was compressed using the save section of the scenario file (the start date state)
+   as a prefix, which the client must have an identical copy of */
+struct network_save_header {
+	sys::checksum_key reference_checksum;
+	uint32_t compressed_length = 0;
+	uint32_t decompressed_length = 0;
+	uint32_t reference_length = 0;
+	uint32_t reserved = 0;
+};
+
+struct tick_checksum {
+	sys::checksum_key checksum;
+	sys::date date;
+};
+
 struct client_data {
 	dcon::nation_id playing_as{};
 	socket_t socket_fd = 0;
@@ -56,17 +81,72 @@ struct client_data {
 	std::vector<char> send_buffer;
 
 	// accounting for save progress
-	size_t total_sent_bytes = 0;
+	std::atomic<size_t> total_sent_bytes = 0;
 	size_t save_stream_offset = 0;
 	size_t save_stream_size = 0;
+	// positions in send_buffer where the save goes once it is compressed, nothing is sent to the client until then
+	std::vector<size_t> save_slots;
 	bool handshake = true;
 
+#ifndef _WIN64
+	uint32_t io_generation = 0; // generation of the network thread slot this client is bound to
+	size_t total_queued_bytes = 0; // bytes handed over to the network thread so far
+	std::atomic<size_t> io_pending_bytes = 0; // bytes handed over to the network thread but not yet sent
+#endif
+
 	bool is_banned(sys::state& state) const;
 	inline bool is_active() const {
 		return socket_fd > 0;
 	}
+	inline bool has_pending_send() const {
+#ifndef _WIN64
+		return !send_buffer.empty() || io_pending_bytes.load(std::memory_order::acquire) > 0;
+#else
+		return !send_buffer.empty();
+#endif
+	}
 };
 
+#ifndef _WIN64
+/* On NIX the host does all of its socket I/O on a dedicated network thread multiplexed with epoll,
+   the game thread only ever exchanges already decoded data with it through the queues below */
+enum class io_event_type : uint8_t {
+	client_accepted, client_handshake, client_command, client_disconnected
+};
+struct io_event {
+	command::payload cmd;
+	client_handshake_data hshake;
+	struct sockaddr_in6 v6_address{}; // of an accepted client
+	struct sockaddr_in v4_address{};
+	socket_t socket_fd = 0;
+	uint32_t generation = 0;
+	uint8_t client_index = 0;
+	io_event_type type = io_event_type::client_accepted;
+};
+enum class io_request_type : uint8_t {
+	close_client
+};
+struct io_request {
+	uint32_t generation = 0;
+	uint8_t client_index = 0;
+	io_request_type type = io_request_type::close_client;
+};
+/* Per client data owned by the network thread, only pending_send is shared (guarded by send_lock) */
+struct client_io_data {
+	std::mutex send_lock;
+	std::vector<char> pending_send; // written by the game thread
+	std::vector<char> out_buffer; // being written to the socket
+	size_t out_offset = 0;
+	client_handshake_data hshake_buffer;
+	command::payload recv_buffer;
+	size_t recv_count = 0;
+	socket_t socket_fd = 0;
+	uint32_t generation = 0;
+	bool handshake = true;
+	bool want_write = false;
+};
+#endif
+
 struct network_state {
 	bool as_v6 = false;
 	bool as_server = false;
@@ -100,24 +180,50 @@ struct network_state {
 
 	uint32_t current_save_length = 0;
 	std::unique_ptr<uint8_t[]> current_save_buffer;
+	std::thread save_compressor; // compresses current_save_buffer in the background
+	std::atomic<bool> save_compressed = true;
+
+	std::vector<uint8_t> save_reference; // save section of the scenario file, which network saves are deltas against
+	sys::checksum_key save_reference_scenario; // checksum of the scenario the reference was read from
+	sys::checksum_key save_reference_checksum;
 
 	sys::player_name nickname;
 	ankerl::unordered_dense::map<int32_t, sys::player_name> map_of_player_names;
 
+	sys::date last_frame_date; // last date announced to (host) or reached by (client) a lockstep frame
+	std::chrono::steady_clock::time_point last_frame_time;
+	std::array<tick_checksum, 32> tick_checksums; // most recently verified dates, for diagnosing desyncs
+	uint32_t tick_checksum_count = 0;
+
 	std::atomic<bool> save_slock = false;
 
+#ifndef _WIN64
+	std::thread io_thread;
+	std::atomic<bool> io_quit = false;
+	int epoll_fd = -1;
+	int io_wakeup_fd = -1;
+	rigtorp::SPSCQueue<io_event> io_events; // network thread -> game thread
+	rigtorp::SPSCQueue<io_request> io_requests; // game thread -> network thread
+	std::array<client_io_data, 16> io_clients;
+
+	network_state() : outgoing_commands(1024), io_events(1024), io_requests(256) {}
+#else
 	network_state() : outgoing_commands(1024) {}
+#endif
 	~network_state() {}
 };
 
 void init(sys::state& state);
-void send_and_receive_commands(sys::state& state);
+bool send_and_receive_commands(sys::state& state);
 void finish(sys::state& state);
 void ban_player(sys::state& state, client_data& client);
 void kick_player(sys::state& state, client_data& client);
 void switch_player(sys::state& state, dcon::nation_id new_n, dcon::nation_id old_n);
-uint32_t write_network_save(sys::state& state, std::unique_ptr<uint8_t[]>& buffer);
-void broadcast_save_to_clients(sys::state& state, command::payload& c, uint8_t const* buffer, uint32_t length);
+void write_network_save(sys::state& state);
+void clear_network_save(sys::state& state);
+void broadcast_save_to_clients(sys::state& state, command::payload& c);
 void broadcast_to_clients(sys::state& state, command::payload& c);
+bool frame_needs_checksum(sys::state& state, sys::date from, sys::date to);
+void record_tick_checksum(sys::state& state, sys::date date, sys::checksum_key const& checksum);
 
 }
@@ -402,6 +402,18 @@ void load_global_squares(sys::state& state) {
 
 		glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * 16, global_sub_square_data, GL_STATIC_DRAW);
 	}
+
+	// the buffer itself is sized on demand by flush_quad_batch
+	glGenBuffers(1, &state.open_gl.batch_buffer);
+	glGenVertexArrays(1, &state.open_gl.batch_vao);
+	glBindVertexArray(state.open_gl.batch_vao);
+	glEnableVertexAttribArray(0); // position
+	glEnableVertexAttribArray(1); // texture coordinates
+	glVertexAttribFormat(0, 2, GL_FLOAT, GL_FALSE, offsetof(quad_batch_vertex, x));
+	glVertexAttribFormat(1, 2, GL_FLOAT, GL_FALSE, offsetof(quad_batch_vertex, u));
+	glVertexAttribBinding(0, 0);
+	glVertexAttribBinding(1, 0);
+	glBindVertexArray(0);
 }
 
 inline auto map_color_modification_to_index(color_modification e) {
@@ -441,42 +453,69 @@ void bind_vertices_by_rotation(sys::state const& state, ui::rotation r, bool fli
 	}
 }
 
-void render_textured_rect(sys::state const& state, color_modification enabled, float x, float y, float width, float height,
-		GLuint texture_handle, ui::rotation r, bool flipped) {
-	glBindVertexArray(state.open_gl.global_square_vao);
-
-	bind_vertices_by_rotation(state, r, flipped);
+// the same corners as the buffer bind_vertices_by_rotation picks
+float const* square_data_by_rotation(ui::rotation r, bool flipped) {
+	switch(r) {
+	case ui::rotation::r90_left:
+		return flipped ? global_square_left_flipped_data : global_square_left_data;
+	case ui::rotation::r90_right:
+		return flipped ? global_square_right_flipped_data : global_square_right_data;
+	case ui::rotation::upright:
+	default:
+		return flipped ? global_square_flipped_data : global_square_data;
+	}
+}
 
-	glUniform4f(parameters::drawing_rectangle, x, y, width, height);
-	// glUniform4f(parameters::drawing_rectangle, 0, 0, width, height);
+void flush_quad_batch(sys::state const& state) {
+	auto& batch = state.open_gl.batch;
+	if(batch.empty())
+		return;
 
+	glBindVertexArray(state.open_gl.batch_vao);
+	glBindBuffer(GL_ARRAY_BUFFER, state.open_gl.batch_buffer);
+	auto size = sizeof(quad_batch_vertex) * batch.vertices.size();
+	if(size > state.open_gl.batch_buffer_size)
+		state.open_gl.batch_buffer_size = std::max(size, state.open_gl.batch_buffer_size * 2);
+	// orphan the storage the previous flush drew from instead of waiting for the gpu to finish with it
+	glBufferData(GL_ARRAY_BUFFER, state.open_gl.batch_buffer_size, nullptr, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, size, batch.vertices.data());
+	glBindVertexBuffer(0, state.open_gl.batch_buffer, 0, sizeof(quad_batch_vertex));
+
+	// the vertices are already in ui pixels and the texture coordinates already point into the sub rectangle
+	glUniform4f(parameters::drawing_rectangle, 0.0f, 0.0f, 1.0f, 1.0f);
+	glUniform4f(parameters::subrect, 0.0f, 1.0f, 0.0f, 1.0f);
 	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, texture_handle);
-
-	GLuint subroutines[2] = {map_color_modification_to_index(enabled), parameters::no_filter};
-	glUniformSubroutinesuiv(GL_FRAGMENT_SHADER, 2, subroutines); // must set all subroutines in one call
+	for(auto const& run : batch.runs) {
+		glBindTexture(GL_TEXTURE_2D, run.key.texture);
+		glUniform3f(parameters::inner_color, run.key.inner_r, run.key.inner_g, run.key.inner_b);
+		glUniform1f(parameters::border_size, run.key.border_size);
+		GLuint subroutines[2] = {run.key.color_subroutine, run.key.font_subroutine};
+		glUniformSubroutinesuiv(GL_FRAGMENT_SHADER, 2, subroutines); // must set all subroutines in one call
+		glDrawArrays(GL_TRIANGLES, GLint(run.first_vertex), GLsizei(run.vertex_count));
+	}
+	batch.clear();
+}
 
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+void render_textured_rect(sys::state const& state, color_modification enabled, float x, float y, float width, float height,
+		GLuint texture_handle, ui::rotation r, bool flipped) {
+	quad_batch_key key;
+	key.texture = texture_handle;
+	key.color_subroutine = map_color_modification_to_index(enabled);
+	key.font_subroutine = parameters::no_filter;
+	state.open_gl.batch.add_quad(key, square_data_by_rotation(r, flipped), x, y, width, height);
 }
 
 void render_textured_rect_direct(sys::state const& state, float x, float y, float width, float height, uint32_t handle) {
-	glBindVertexArray(state.open_gl.global_square_vao);
-
-	glBindVertexBuffer(0, state.open_gl.global_square_buffer, 0, sizeof(GLfloat) * 4);
-
-	glUniform4f(parameters::drawing_rectangle, x, y, width, height);
-
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, handle);
-
-	GLuint subroutines[2] = {parameters::enabled, parameters::no_filter};
-	glUniformSubroutinesuiv(GL_FRAGMENT_SHADER, 2, subroutines); // must set all subroutines in one call
-
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+	quad_batch_key key;
+	key.texture = handle;
+	key.color_subroutine = parameters::enabled;
+	key.font_subroutine = parameters::no_filter;
+	state.open_gl.batch.add_quad(key, global_square_data, x, y, width, height);
 }
 
 void render_linegraph(sys::state const& state, color_modification enabled, float x, float y, float width, float height,
 		lines& l) {
+	flush_quad_batch(state);
 	glBindVertexArray(state.open_gl.global_square_vao);
 
 	l.bind_buffer();
@@ -492,6 +531,7 @@ void render_linegraph(sys::state const& state, color_modification enabled, float
 
 void render_barchart(sys::state const& state, color_modification enabled, float x, float y, float width, float height,
 		data_texture& t, ui::rotation r, bool flipped) {
+	flush_quad_batch(state);
 	glBindVertexArray(state.open_gl.global_square_vao);
 
 	bind_vertices_by_rotation(state, r, flipped);
@@ -508,6 +548,7 @@ void render_barchart(sys::state const& state, color_modification enabled, float
 }
 
 void render_piechart(sys::state const& state, color_modification enabled, float x, float y, float size, data_texture& t) {
+	flush_quad_batch(state);
 	glBindVertexArray(state.open_gl.global_square_vao);
 
 	glBindVertexBuffer(0, state.open_gl.global_square_buffer, 0, sizeof(GLfloat) * 4);
@@ -525,6 +566,7 @@ void render_piechart(sys::state const& state, color_modification enabled, float
 
 void render_bordered_rect(sys::state const& state, color_modification enabled, float border_size, float x, float y, float width,
 		float height, GLuint texture_handle, ui::rotation r, bool flipped) {
+	flush_quad_batch(state);
 	glBindVertexArray(state.open_gl.global_square_vao);
 
 	bind_vertices_by_rotation(state, r, flipped);
@@ -543,6 +585,7 @@ void render_bordered_rect(sys::state const& state, color_modification enabled, f
 
 void render_masked_rect(sys::state const& state, color_modification enabled, float x, float y, float width, float height,
 		GLuint texture_handle, GLuint mask_texture_handle, ui::rotation r, bool flipped) {
+	flush_quad_batch(state);
 	glBindVertexArray(state.open_gl.global_square_vao);
 
 	bind_vertices_by_rotation(state, r, flipped);
@@ -562,6 +605,7 @@ void render_masked_rect(sys::state const& state, color_modification enabled, flo
 
 void render_progress_bar(sys::state const& state, color_modification enabled, float progress, float x, float y, float width,
 		float height, GLuint left_texture_handle, GLuint right_texture_handle, ui::rotation r, bool flipped) {
+	flush_quad_batch(state);
 	glBindVertexArray(state.open_gl.global_square_vao);
 
 	bind_vertices_by_rotation(state, r, flipped);
@@ -582,24 +626,19 @@ void render_progress_bar(sys::state const& state, color_modification enabled, fl
 
 void render_tinted_textured_rect(sys::state const& state, float x, float y, float width, float height, float r, float g, float b,
 		GLuint texture_handle, ui::rotation rot, bool flipped) {
-	glBindVertexArray(state.open_gl.global_square_vao);
-
-	bind_vertices_by_rotation(state, rot, flipped);
-
-	glUniform3f(parameters::inner_color, r, g, b);
-	glUniform4f(parameters::drawing_rectangle, x, y, width, height);
-
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, texture_handle);
-
-	GLuint subroutines[2] = {parameters::tint, parameters::no_filter};
-	glUniformSubroutinesuiv(GL_FRAGMENT_SHADER, 2, subroutines); // must set all subroutines in one call
-
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+	quad_batch_key key;
+	key.texture = texture_handle;
+	key.color_subroutine = parameters::tint;
+	key.font_subroutine = parameters::no_filter;
+	key.inner_r = r;
+	key.inner_g = g;
+	key.inner_b = b;
+	state.open_gl.batch.add_quad(key, square_data_by_rotation(rot, flipped), x, y, width, height);
 }
 
 void render_tinted_subsprite(sys::state const& state, int frame, int total_frames, float x, float y,
 		float width, float height, float r, float g, float b, GLuint texture_handle, ui::rotation rot, bool flipped) {
+	flush_quad_batch(state);
 	glBindVertexArray(state.open_gl.global_square_vao);
 
 	bind_vertices_by_rotation(state, rot, flipped);
@@ -620,43 +659,36 @@ void render_tinted_subsprite(sys::state const& state, int frame, int total_frame
 
 void render_subsprite(sys::state const& state, color_modification enabled, int frame, int total_frames, float x, float y,
 		float width, float height, GLuint texture_handle, ui::rotation r, bool flipped) {
-	glBindVertexArray(state.open_gl.global_square_vao);
-
-	bind_vertices_by_rotation(state, r, flipped);
-
+	// the frame is picked through the texture coordinates, which is what the sub_sprite subroutine would do
 	auto const scale = 1.0f / static_cast<float>(total_frames);
-	glUniform3f(parameters::inner_color, static_cast<float>(frame) * scale, scale, 0.0f);
-	glUniform4f(parameters::drawing_rectangle, x, y, width, height);
-
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, texture_handle);
-
-	GLuint subroutines[2] = {map_color_modification_to_index(enabled), parameters::sub_sprite};
-	glUniformSubroutinesuiv(GL_FRAGMENT_SHADER, 2, subroutines); // must set all subroutines in one call
+	quad_batch_key key;
+	key.texture = texture_handle;
+	key.color_subroutine = map_color_modification_to_index(enabled);
+	key.font_subroutine = parameters::no_filter;
+	state.open_gl.batch.add_quad(key, square_data_by_rotation(r, flipped), x, y, width, height, static_cast<float>(frame) * scale, scale);
+}
 
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+// glyph i of a font texture is cell i of its 8 by 8 grid, as in the sub square buffers
+void add_glyph_quad(sys::state const& state, quad_batch_key const& key, uint8_t codepoint, float x, float y, float size) {
+	float const cell_x = static_cast<float>(codepoint & 7) / 8.0f;
+	float const cell_y = static_cast<float>((codepoint >> 3) & 7) / 8.0f;
+	state.open_gl.batch.add_quad(key, global_square_data, x, y, size, size, cell_x, 1.0f / 8.0f, cell_y, 1.0f / 8.0f);
 }
 
 void render_character(sys::state const& state, char codepoint, color_modification enabled, float x, float y, float size, text::font& f) {
 	if(text::win1250toUTF16(codepoint) != ' ') {
 		// f.make_glyph(codepoint);
 
-		glBindVertexBuffer(0, state.open_gl.sub_square_buffers[uint8_t(codepoint) & 63], 0, sizeof(GLfloat) * 4);
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, f.textures[uint8_t(codepoint) >> 6]);
-
-		glUniform4f(parameters::drawing_rectangle, x, y, size, size);
-		glUniform3f(parameters::inner_color, 0.0f, 0.0f, 0.0f);
-		glUniform1f(parameters::border_size, 0.06f * 16.0f / size);
-
-		GLuint subroutines[2] = {map_color_modification_to_index(enabled), parameters::border_filter};
-		glUniformSubroutinesuiv(GL_FRAGMENT_SHADER, 2, subroutines); // must set all subroutines in one call
-
-		glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+		quad_batch_key key;
+		key.texture = f.textures[uint8_t(codepoint) >> 6];
+		key.color_subroutine = map_color_modification_to_index(enabled);
+		key.font_subroutine = parameters::border_filter;
+		key.border_size = 0.06f * 16.0f / size;
+		add_glyph_quad(state, key, uint8_t(codepoint), x, y, size);
 	}
 }
 
-GLuint get_flag_texture_handle_from_tag(sys::state& state, char tag[3]) {
+dcon::national_identity_id get_identity_from_tag(sys::state& state, char tag[3]) {
 	tag[0] = char(toupper(tag[0]));
 	tag[1] = char(toupper(tag[1]));
 	tag[2] = char(toupper(tag[2]));
@@ -668,10 +700,10 @@ GLuint get_flag_texture_handle_from_tag(sys::state& state, char tag[3]) {
 			ident = id;
 		}
 	});
-	if(!bool(ident)) {
-		// QOL: We will print the text instead of displaying the flag, for ease of viewing invalid tags
-		return 0;
-	}
+	return ident;
+}
+
+GLuint get_flag_texture_handle_from_identity(sys::state& state, dcon::national_identity_id ident) {
 	auto fat_id = dcon::fatten(state.world, ident);
 	auto nation = fat_id.get_nation_from_identity_holder();
 	culture::flag_type flag_type = culture::flag_type{};
@@ -683,6 +715,15 @@ GLuint get_flag_texture_handle_from_tag(sys::state& state, char tag[3]) {
 	return ogl::get_flag_handle(state, ident, flag_type);
 }
 
+GLuint get_flag_texture_handle_from_tag(sys::state& state, char tag[3]) {
+	auto ident = get_identity_from_tag(state, tag);
+	if(!bool(ident)) {
+		// QOL: We will print the text instead of displaying the flag, for ease of viewing invalid tags
+		return 0;
+	}
+	return get_flag_texture_handle_from_identity(state, ident);
+}
+
 bool display_tag_is_valid(sys::state& state, char tag[3]) {
 	tag[0] = char(toupper(tag[0]));
 	tag[1] = char(toupper(tag[1]));
@@ -696,8 +737,9 @@ bool display_tag_is_valid(sys::state& state, char tag[3]) {
 	return bool(ident);
 }
 
-void internal_text_render(sys::state& state, char const* codepoints, uint32_t count, float x, float baseline_y, float size,
-		text::font& f, GLuint const* subroutines, GLuint const* icon_subroutines) {
+void make_glyph_run(sys::state& state, char const* codepoints, uint32_t count, float size, text::font& f, glyph_run& run) {
+	run.entries.clear();
+	float x = 0.0f;
 	for(uint32_t i = 0; i < count; ++i) {
 		if(text::win1250toUTF16(codepoints[i]) != ' ') {
 			// f.make_glyph(codepoints[i]);
@@ -706,18 +748,15 @@ void internal_text_render(sys::state& state, char const* codepoints, uint32_t co
 				tag[0] = (i + 1 < count) ? char(codepoints[i + 1]) : 0;
 				tag[1] = (i + 2 < count) ? char(codepoints[i + 2]) : 0;
 				tag[2] = (i + 3 < count) ? char(codepoints[i + 3]) : 0;
-				GLuint flag_texture_handle = get_flag_texture_handle_from_tag(state, tag);
-				if(flag_texture_handle != 0) {
-					bind_vertices_by_rotation(state, ui::rotation::upright, false);
-					glActiveTexture(GL_TEXTURE0);
-					glUniformSubroutinesuiv(GL_FRAGMENT_SHADER, 2, icon_subroutines);
-					glBindTexture(GL_TEXTURE_2D, flag_texture_handle);
-					glUniform4f(parameters::drawing_rectangle, x,
-							baseline_y + f.glyph_positions[0x4D].y * size / 64.0f, size * 1.5f, size);
-					glUniform4f(ogl::parameters::subrect, 0.f /* x offset */, 1.f /* x width */, 0.f /* y offset */, 1.f /* y height */
-					);
-					glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-					glUniformSubroutinesuiv(GL_FRAGMENT_SHADER, 2, subroutines);
+				auto ident = get_identity_from_tag(state, tag);
+				if(ident) {
+					glyph_run_entry e;
+					e.x = x;
+					e.y = f.glyph_positions[0x4D].y * size / 64.0f;
+					e.width = size * 1.5f;
+					e.height = size;
+					e.flag = ident;
+					run.entries.push_back(e);
 
 					x += size * 1.5f;
 					
@@ -727,36 +766,34 @@ void internal_text_render(sys::state& state, char const* codepoints, uint32_t co
 			}  // fallthrough on purpose: if it doesn't match a flag, render it as text
 
 			if(text::win1250toUTF16(codepoints[i]) == u'\u0001' || text::win1250toUTF16(codepoints[i]) == u'\u0002') {
-				bind_vertices_by_rotation(state, ui::rotation::upright, false);
-				glActiveTexture(GL_TEXTURE0);
-				glUniformSubroutinesuiv(GL_FRAGMENT_SHADER, 2, icon_subroutines);
-				glBindTexture(GL_TEXTURE_2D, text::win1250toUTF16(codepoints[i]) == u'\u0001' ? state.open_gl.cross_icon_tex : state.open_gl.checkmark_icon_tex);
-				glUniform4f(parameters::drawing_rectangle, x, baseline_y + f.glyph_positions[0x4D].y * size / 64.0f, size, size);
-				glUniform4f(ogl::parameters::subrect, 0.f /* x offset */, 1.f /* x width */, 0.f /* y offset */, 1.f /* y height */
-				);
-				glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-				glUniformSubroutinesuiv(GL_FRAGMENT_SHADER, 2, subroutines);
+				glyph_run_entry e;
+				e.x = x;
+				e.y = f.glyph_positions[0x4D].y * size / 64.0f;
+				e.width = size;
+				e.height = size;
+				e.texture = text::win1250toUTF16(codepoints[i]) == u'\u0001' ? state.open_gl.cross_icon_tex : state.open_gl.checkmark_icon_tex;
+				run.entries.push_back(e);
 
 				x += size;
 			} else if(text::win1250toUTF16(codepoints[i]) == u'\u0003' || text::win1250toUTF16(codepoints[i]) == u'\u0004') {
-				bind_vertices_by_rotation(state, ui::rotation::upright, false);
-				glActiveTexture(GL_TEXTURE0);
-				glUniformSubroutinesuiv(GL_FRAGMENT_SHADER, 2, icon_subroutines);
-				glBindTexture(GL_TEXTURE_2D, text::win1250toUTF16(codepoints[i]) == u'\u0003' ? state.open_gl.army_icon_tex : state.open_gl.navy_icon_tex);
-				glUniform4f(parameters::drawing_rectangle, x - size * 0.125f, baseline_y - size * 0.25f + f.glyph_positions[0x4D].y * size / 64.0f, size * 1.5f, size * 1.5f);
-				glUniform4f(ogl::parameters::subrect, 0.f /* x offset */, 1.f /* x width */, 0.f /* y offset */, 1.f /* y height */
-				);
-				glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-				glUniformSubroutinesuiv(GL_FRAGMENT_SHADER, 2, subroutines);
+				glyph_run_entry e;
+				e.x = x - size * 0.125f;
+				e.y = -size * 0.25f + f.glyph_positions[0x4D].y * size / 64.0f;
+				e.width = size * 1.5f;
+				e.height = size * 1.5f;
+				e.texture = text::win1250toUTF16(codepoints[i]) == u'\u0003' ? state.open_gl.army_icon_tex : state.open_gl.navy_icon_tex;
+				run.entries.push_back(e);
 
 				x += size;
 			} else {
-				glBindVertexBuffer(0, state.open_gl.sub_square_buffers[uint8_t(codepoints[i]) & 63], 0, sizeof(GLfloat) * 4);
-				glActiveTexture(GL_TEXTURE0);
-				glBindTexture(GL_TEXTURE_2D, f.textures[uint8_t(codepoints[i]) >> 6]);
-				glUniform4f(parameters::drawing_rectangle, x + f.glyph_positions[uint8_t(codepoints[i])].x * size / 64.0f,
-						baseline_y + f.glyph_positions[uint8_t(codepoints[i])].y * size / 64.0f, size, size);
-				glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+				glyph_run_entry e;
+				e.x = x + f.glyph_positions[uint8_t(codepoints[i])].x * size / 64.0f;
+				e.y = f.glyph_positions[uint8_t(codepoints[i])].y * size / 64.0f;
+				e.width = size;
+				e.height = size;
+				e.glyph = uint8_t(codepoints[i]);
+				e.is_glyph = true;
+				run.entries.push_back(e);
 
 				x += f.glyph_advances[uint8_t(codepoints[i])] * size / 64.0f +
 						 ((i != count - 1) ? f.kerning(codepoints[i], codepoints[i + 1]) * size / 64.0f : 0.0f);
@@ -768,41 +805,81 @@ void internal_text_render(sys::state& state, char const* codepoints, uint32_t co
 	}
 }
 
+// Text rarely changes from one frame to the next, so its layout is kept around and only looked up again
+glyph_run const& get_glyph_run(sys::state& state, char const* codepoints, uint32_t count, float size, text::font& f) {
+	auto text = std::string_view(codepoints, count);
+	uint64_t key = ankerl::unordered_dense::hash<std::string_view>{}(text);
+	key ^= (uint64_t(reinterpret_cast<uintptr_t>(&f)) + uint64_t(size * 64.0f)) * 0x9E3779B97F4A7C15ull;
+
+	auto& runs = state.open_gl.glyph_runs;
+	if(auto it = runs.find(key); it != runs.end()) {
+		auto& run = it->second;
+		if(run.font == &f && run.size == size && run.text == text)
+			return run;
+		// a hash collision: lay the new text out in its place
+	} else if(runs.size() >= 8192) {
+		runs.clear(); // text that was on screen a moment ago will simply be laid out again
+	}
+
+	auto& run = runs[key];
+	run.text = std::string(text);
+	run.font = &f;
+	run.size = size;
+	make_glyph_run(state, codepoints, count, size, f, run);
+	return run;
+}
+
+void internal_text_render(sys::state& state, char const* codepoints, uint32_t count, float x, float baseline_y, float size,
+		text::font& f, quad_batch_key const& glyph_key, quad_batch_key const& icon_key) {
+	auto const& run = get_glyph_run(state, codepoints, count, size, f);
+	for(auto const& e : run.entries) {
+		if(e.is_glyph) {
+			quad_batch_key key = glyph_key;
+			key.texture = f.textures[e.glyph >> 6];
+			add_glyph_quad(state, key, e.glyph, x + e.x, baseline_y + e.y, size);
+		} else {
+			quad_batch_key key = icon_key;
+			key.texture = e.flag ? get_flag_texture_handle_from_identity(state, e.flag) : e.texture;
+			state.open_gl.batch.add_quad(key, global_square_data, x + e.x, baseline_y + e.y, e.width, e.height);
+		}
+	}
+}
+
 void render_new_text(sys::state& state, char const* codepoints, uint32_t count, color_modification enabled, float x,
 		float y, float size, color3f const& c, text::font& f) {
-	glUniform3f(parameters::inner_color, c.r, c.g, c.b);
-	glUniform1f(parameters::border_size, 0.08f * 16.0f / size);
+	quad_batch_key glyph_key;
+	glyph_key.color_subroutine = map_color_modification_to_index(enabled);
+	glyph_key.font_subroutine = parameters::filter;
+	glyph_key.inner_r = c.r;
+	glyph_key.inner_g = c.g;
+	glyph_key.inner_b = c.b;
+	glyph_key.border_size = 0.08f * 16.0f / size;
+
+	quad_batch_key icon_key;
+	icon_key.color_subroutine = map_color_modification_to_index(enabled);
+	icon_key.font_subroutine = parameters::no_filter;
 
-	GLuint subroutines[2] = {map_color_modification_to_index(enabled), parameters::filter};
-	GLuint icon_subroutines[2] = {map_color_modification_to_index(enabled), parameters::no_filter};
-	glUniformSubroutinesuiv(GL_FRAGMENT_SHADER, 2, subroutines);
-	internal_text_render(state, codepoints, count, x, y + size, size, f, subroutines, icon_subroutines);
+	internal_text_render(state, codepoints, count, x, y + size, size, f, glyph_key, icon_key);
 }
 
 void render_classic_text(sys::state& state, float x, float y, char const* codepoints, uint32_t count,
 		color_modification enabled, color3f const& c, text::bm_font const& font) {
 	float adv = 1.0f / font.width; // Font texture atlas spacing.
 
-	bind_vertices_by_rotation(state, ui::rotation::upright, false);
-
-	GLuint subroutines[2] = {map_color_modification_to_index(enabled), parameters::subsprite_b};
-	glUniformSubroutinesuiv(GL_FRAGMENT_SHADER, 2, subroutines);
+	// Every iteration of this loop queues one character of the string, or an icon in its place. The glyph is picked out
+	// of the font texture through the texture coordinates, which is what the subsprite_b subroutine does with subrect.
+	// Spacing, kerning, etc. are already applied by the font.
 
-	// Set Text Color, all one color for now.
+	quad_batch_key glyph_key;
+	glyph_key.texture = font.ftexid;
+	glyph_key.color_subroutine = map_color_modification_to_index(enabled);
+	glyph_key.font_subroutine = parameters::subsprite_b;
+	glyph_key.inner_r = c.r;
+	glyph_key.inner_g = c.g;
+	glyph_key.inner_b = c.b;
 
-	//------ FOR SCHOMBERT ------//
-	// Every iteration of this loop draws one character of the string 'fmt'.
-	//'texlst' contains information for each vertex of each rectangle for each character.
-	// Every 4 elements in 'texlst' is one complete rectangle, and one character.
-	//'texlst[i].texx' and 'texlst[i].texy' are the intended texture coordinates of a vertex on the texture.
-	//'texlst[i].x' and 'texlst[i].y' are the coordinates of a vertex of the rendered rectangle in the window.
-	// The color variables are unused currently.
-	//
-	// Spacing, kearning, etc. are already applied.
-	// Scaling (unintentionally) is also applied (by whatever part of Alice scales the normal fonts).
-
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, font.ftexid);
+	quad_batch_key icon_key = glyph_key;
+	icon_key.font_subroutine = parameters::no_filter;
 
 	for(uint32_t i = 0; i < count; ++i) {
 		auto f = font.chars[0];
@@ -813,24 +890,14 @@ void render_classic_text(sys::state& state, float x, float y, char const* codepo
 			tag[2] = (i + 3 < count) ? char(codepoints[i + 3]) : 0;
 			GLuint flag_texture_handle = get_flag_texture_handle_from_tag(state, tag);
 			if(flag_texture_handle != 0) {
-				GLuint flag_subroutines[2] = {map_color_modification_to_index(enabled), parameters::no_filter};
-				glUniformSubroutinesuiv(GL_FRAGMENT_SHADER, 2, flag_subroutines);
 				f = font.chars[0x4D];
 				float scaling = uint8_t(codepoints[i]) == 0xA4 ? 1.5f : 1.f;
 				float offset = uint8_t(codepoints[i]) == 0xA4 ? 0.25f : 0.f;
 				float CurX = x + f.x_offset - (float(f.width) * offset);
 				float CurY = y + f.y_offset - (float(f.height) * offset);
-				glUniform4f(ogl::parameters::drawing_rectangle, CurX, CurY, float(f.height) * 1.5f * scaling, float(f.height) * scaling);
-				glBindTexture(GL_TEXTURE_2D, flag_texture_handle);
-				glUniform3f(parameters::inner_color, c.r, c.g, c.b);
-				glUniform4f(ogl::parameters::subrect, float(f.x) / float(font.width) /* x offset */,
-						float(f.width) / float(font.width) /* x width */, float(f.y) / float(font.width) /* y offset */,
-						float(f.height) / float(font.width) /* y height */
-				);
-				glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-				// Restore affected state
-				glBindTexture(GL_TEXTURE_2D, font.ftexid);
-				glUniformSubroutinesuiv(GL_FRAGMENT_SHADER, 2, subroutines);
+				quad_batch_key key = icon_key;
+				key.texture = flag_texture_handle;
+				state.open_gl.batch.add_quad(key, global_square_data, CurX, CurY, float(f.height) * 1.5f * scaling, float(f.height) * scaling);
 
 				x += f.x_offset - (float(f.width) * offset) + float(f.height) * 1.5f * scaling;
 
@@ -840,14 +907,11 @@ void render_classic_text(sys::state& state, float x, float y, char const* codepo
 		}
 
 		if(uint8_t(codepoints[i]) == 0xA4 || uint8_t(codepoints[i]) == 0x01 || uint8_t(codepoints[i]) == 0x02 || int8_t(codepoints[i]) == 0x03 || uint8_t(codepoints[i]) == 0x04) {
-			GLuint money_subroutines[2] = {map_color_modification_to_index(enabled), parameters::no_filter};
-			glUniformSubroutinesuiv(GL_FRAGMENT_SHADER, 2, money_subroutines);
 			f = font.chars[0x4D];
 			float scaling = uint8_t(codepoints[i]) == 0xA4 ? 1.5f : 1.f;
 			float offset = uint8_t(codepoints[i]) == 0xA4 ? 0.25f : 0.f;
 			float CurX = x + f.x_offset - (float(f.width) * offset);
 			float CurY = y + f.y_offset - (float(f.height) * offset);
-			glUniform4f(ogl::parameters::drawing_rectangle, CurX, CurY, float(f.width) * scaling, float(f.height) * scaling);
 
 			GLuint icon_tex = 0;
 			if(uint8_t(codepoints[i]) == 0xA4)
@@ -861,16 +925,9 @@ void render_classic_text(sys::state& state, float x, float y, char const* codepo
 			else if(uint8_t(codepoints[i]) == 0x04)
 				icon_tex = state.open_gl.navy_icon_tex;
 
-			glBindTexture(GL_TEXTURE_2D, icon_tex);
-			glUniform3f(parameters::inner_color, c.r, c.g, c.b);
-			glUniform4f(ogl::parameters::subrect, float(f.x) / float(font.width) /* x offset */,
-					float(f.width) / float(font.width) /* x width */, float(f.y) / float(font.width) /* y offset */,
-					float(f.height) / float(font.width) /* y height */
-			);
-			glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-			// Restore affected state
-			glBindTexture(GL_TEXTURE_2D, font.ftexid);
-			glUniformSubroutinesuiv(GL_FRAGMENT_SHADER, 2, subroutines);
+			quad_batch_key key = icon_key;
+			key.texture = icon_tex;
+			state.open_gl.batch.add_quad(key, global_square_data, CurX, CurY, float(f.width) * scaling, float(f.height) * scaling);
 
 			x += f.x_offset - (float(f.width) * offset) + float(f.width) * scaling;
 			continue;
@@ -878,13 +935,9 @@ void render_classic_text(sys::state& state, float x, float y, char const* codepo
 			f = font.chars[uint8_t(codepoints[i])];
 			float CurX = x + f.x_offset;
 			float CurY = y + f.y_offset;
-			glUniform4f(ogl::parameters::drawing_rectangle, CurX, CurY, float(f.width), float(f.height));
-			glUniform3f(parameters::inner_color, c.r, c.g, c.b);
-			glUniform4f(ogl::parameters::subrect, float(f.x) / float(font.width) /* x offset */,
-					float(f.width) / float(font.width) /* x width */, float(f.y) / float(font.width) /* y offset */,
-					float(f.height) / float(font.width) /* y height */
-			);
-			glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+			state.open_gl.batch.add_quad(glyph_key, global_square_data, CurX, CurY, float(f.width), float(f.height),
+					float(f.x) / float(font.width) /* x offset */, float(f.width) / float(font.width) /* x width */,
+					float(f.y) / float(font.width) /* y offset */, float(f.height) / float(font.width) /* y height */);
 		}
 
 		// Only check kerning if there is greater then 1 character and
@@ -11,6 +11,7 @@
 #include "container_types.hpp"
 #include "texture.hpp"
 #include "fonts.hpp"
+#include "quad_batch.hpp"
 
 namespace ogl {
 namespace parameters {
@@ -142,6 +143,26 @@ inline void debug_callback(GLenum source, GLenum type, GLuint id, GLenum severit
 }
 #endif
 
+// One glyph or icon of a line of text, placed relative to the start of the line's baseline
+struct glyph_run_entry {
+	float x = 0.0f;
+	float y = 0.0f;
+	float width = 0.0f;
+	float height = 0.0f;
+	GLuint texture = 0; // for icons
+	dcon::national_identity_id flag; // for flags, which can change with the nation's government, so only the identity is kept
+	uint8_t glyph = 0;
+	bool is_glyph = false;
+};
+
+// A line of text laid out once for a font and size, so that drawing it again only has to place its quads
+struct glyph_run {
+	std::string text;
+	text::font const* font = nullptr;
+	float size = 0.0f;
+	std::vector<glyph_run_entry> entries;
+};
+
 struct data {
 	tagged_vector<texture, dcon::texture_id> asset_textures;
 
@@ -158,6 +179,15 @@ struct data {
 
 	GLuint sub_square_buffers[64] = {0};
 
+	// ui quads waiting to be drawn, see flush_quad_batch
+	mutable quad_batch batch;
+	GLuint batch_vao = 0;
+	GLuint batch_buffer = 0;
+	mutable size_t batch_buffer_size = 0;
+
+	// laid out text by hash of (font, size, text), see render_new_text
+	ankerl::unordered_dense::map<uint64_t, glyph_run> glyph_runs;
+
 	GLuint money_icon_tex = 0;
 	GLuint cross_icon_tex = 0;
 	GLuint checkmark_icon_tex = 0;
@@ -187,6 +217,8 @@ GLint compile_shader(std::string_view source, GLenum type);
 GLuint create_program(std::string_view vertex_shader, std::string_view fragment_shader);
 void load_shaders(sys::state& state);
 void load_global_squares(sys::state& state);
+// draws the quads queued by the render functions below; anything else that draws to the screen must call this first
+void flush_quad_batch(sys::state const& state);
 
 class lines {
 private:
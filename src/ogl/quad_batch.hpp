@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace ogl {
+
+// Everything the ui shader needs to know, besides the vertices themselves, to draw a quad. Consecutive quads with the same
+// key go out in one draw call
+struct quad_batch_key {
+	uint32_t texture = 0;
+	uint32_t color_subroutine = 0;
+	uint32_t font_subroutine = 0;
+	float inner_r = 0.0f;
+	float inner_g = 0.0f;
+	float inner_b = 0.0f;
+	float border_size = 0.0f;
+
+	bool operator==(quad_batch_key const& o) const {
+		return texture == o.texture && color_subroutine == o.color_subroutine && font_subroutine == o.font_subroutine
+			&& inner_r == o.inner_r && inner_g == o.inner_g && inner_b == o.inner_b && border_size == o.border_size;
+	}
+};
+
+// a vertex in ui pixel coordinates, drawn with the drawing rectangle set to (0, 0, 1, 1)
+struct quad_batch_vertex {
+	float x = 0.0f;
+	float y = 0.0f;
+	float u = 0.0f;
+	float v = 0.0f;
+};
+
+struct quad_batch_run {
+	quad_batch_key key;
+	uint32_t first_vertex = 0;
+	uint32_t vertex_count = 0;
+};
+
+// Collects the quads of a frame on the cpu; flush_quad_batch sends them to the gpu. Quads are never reordered, since later
+// ui elements have to draw over earlier ones, so only neighbouring quads with the same key are merged into a run
+class quad_batch {
+public:
+	std::vector<quad_batch_vertex> vertices;
+	std::vector<quad_batch_run> runs;
+
+	// corners is a triangle fan of four (position, texture coordinate) pairs, in the layout of the global square buffers.
+	// The texture coordinates are mapped into the sub rectangle at (u_offset, v_offset) with size (u_scale, v_scale)
+	void add_quad(quad_batch_key const& key, float const* corners, float x, float y, float width, float height,
+			float u_offset = 0.0f, float u_scale = 1.0f, float v_offset = 0.0f, float v_scale = 1.0f) {
+		if(runs.empty() || !(runs.back().key == key)) {
+			runs.push_back(quad_batch_run{ key, uint32_t(vertices.size()), 0 });
+		}
+		auto corner = [&](int32_t i) {
+			return quad_batch_vertex{ corners[i * 4 + 0] * width + x, corners[i * 4 + 1] * height + y,
+				corners[i * 4 + 2] * u_scale + u_offset, corners[i * 4 + 3] * v_scale + v_offset };
+		};
+		vertices.push_back(corner(0));
+		vertices.push_back(corner(1));
+		vertices.push_back(corner(2));
+		vertices.push_back(corner(0));
+		vertices.push_back(corner(2));
+		vertices.push_back(corner(3));
+		runs.back().vertex_count += 6;
+	}
+	bool empty() const {
+		return runs.empty();
+	}
+	void clear() {
+		vertices.clear();
+		runs.clear();
+	}
+};
+
+} // namespace ogl
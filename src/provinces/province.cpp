@@ -4,6 +4,7 @@
 #include "nations.hpp"
 #include "system_state.hpp"
 #include <vector>
+#include <atomic>
 #include "rebels.hpp"
 #include "math_fns.hpp"
 
@@ -164,6 +165,7 @@ void set_province_controller(sys::state& state, dcon::province_id p, dcon::natio
 		}
 		state.world.province_set_rebel_faction_from_province_rebel_control(p, dcon::rebel_faction_id{});
 		state.world.province_set_nation_from_province_control(p, n);
+		update_path_cluster_controllers(state, p);
 		state.military_definitions.pending_blackflag_update = true;
 	}
 }
@@ -187,6 +189,7 @@ void set_province_controller(sys::state& state, dcon::province_id p, dcon::rebel
 		}
 		state.world.province_set_rebel_faction_from_province_rebel_control(p, rf);
 		state.world.province_set_nation_from_province_control(p, dcon::nation_id{});
+		update_path_cluster_controllers(state, p);
 		state.military_definitions.pending_blackflag_update = true;
 	}
 }
@@ -335,8 +338,10 @@ void restore_unsaved_values(sys::state& state) {
 			}
 		});
 	}
+	military::update_unit_presence(state);
 	military::update_blockade_status(state);
 	restore_cached_values(state);
+	build_path_clusters(state);
 }
 
 bool has_railroads_being_built(sys::state& state, dcon::province_id id) {
@@ -729,6 +734,7 @@ void upgrade_colonial_state(sys::state& state, dcon::nation_id source, dcon::sta
 }
 
 void change_province_owner(sys::state& state, dcon::province_id id, dcon::nation_id new_owner) {
+	++state.ownership_epoch;
 	auto state_def = state.world.province_get_state_from_abstract_state_membership(id);
 	auto old_si = state.world.province_get_state_membership(id);
 	auto old_owner = state.world.province_get_nation_from_province_ownership(id);
@@ -868,6 +874,7 @@ void change_province_owner(sys::state& state, dcon::province_id id, dcon::nation
 	state.world.province_set_rebel_faction_from_province_rebel_control(id, dcon::rebel_faction_id{});
 	state.world.province_set_last_control_change(id, state.current_date);
 	state.world.province_set_nation_from_province_control(id, new_owner);
+	update_path_cluster_controllers(state, id);
 	state.world.province_set_siege_progress(id, 0.0f);
 
 	military::eject_ships(state, id);
@@ -1568,6 +1575,7 @@ void set_rgo(sys::state& state, dcon::province_id prov, dcon::commodity_id c) {
 
 void enable_canal(sys::state& state, int32_t id) {
 	state.world.province_adjacency_get_type(state.province_definitions.canals[id]) &= ~province::border::impassible_bit;
+	build_path_clusters(state); // the canal may join two states that had no passable border before; also drops cached paths
 }
 
 // distance between to adjacent provinces
@@ -1607,8 +1615,7 @@ bool has_naval_access_to_province(sys::state& state, dcon::nation_id nation_as,
 	if(state.world.overlord_get_ruler(coverl) == nation_as)
 		return true;
 
-	auto url = state.world.get_unilateral_relationship_by_unilateral_pair(controller, nation_as);
-	if(state.world.unilateral_relationship_get_military_access(url))
+	if(military::relationship_matrix::get(state.military_definitions.relationships.military_access, nation_as, controller))
 		return true;
 
 	if(military::are_allied_in_war(state, nation_as, controller))
@@ -1617,10 +1624,8 @@ bool has_naval_access_to_province(sys::state& state, dcon::nation_id nation_as,
 	return false;
 }
 
-// determines whether a land unit is allowed to move to / be in a province
-bool has_access_to_province(sys::state& state, dcon::nation_id nation_as, dcon::province_id prov) {
-	auto controller = state.world.province_get_nation_from_province_control(prov);
-
+// whether a land unit of nation_as may be in provinces controlled by controller (none: unowned or held by rebels)
+static bool has_land_access_through_controller(sys::state& state, dcon::nation_id nation_as, dcon::nation_id controller) {
 	if(!controller)
 		return true;
 
@@ -1637,8 +1642,7 @@ bool has_access_to_province(sys::state& state, dcon::nation_id nation_as, dcon::
 	if(state.world.overlord_get_ruler(coverl) == nation_as)
 		return true;
 
-	auto url = state.world.get_unilateral_relationship_by_unilateral_pair(controller, nation_as);
-	if(state.world.unilateral_relationship_get_military_access(url))
+	if(military::relationship_matrix::get(state.military_definitions.relationships.military_access, nation_as, controller))
 		return true;
 
 	if(military::are_in_common_war(state, nation_as, controller))
@@ -1647,6 +1651,11 @@ bool has_access_to_province(sys::state& state, dcon::nation_id nation_as, dcon::
 	return false;
 }
 
+// determines whether a land unit is allowed to move to / be in a province
+bool has_access_to_province(sys::state& state, dcon::nation_id nation_as, dcon::province_id prov) {
+	return has_land_access_through_controller(state, nation_as, state.world.province_get_nation_from_province_control(prov));
+}
+
 bool has_safe_access_to_province(sys::state& state, dcon::nation_id nation_as, dcon::province_id prov) {
 	auto controller = state.world.province_get_nation_from_province_control(prov);
 
@@ -1666,8 +1675,7 @@ bool has_safe_access_to_province(sys::state& state, dcon::nation_id nation_as, d
 	if(state.world.overlord_get_ruler(coverl) == nation_as)
 		return true;
 
-	auto url = state.world.get_unilateral_relationship_by_unilateral_pair(controller, nation_as);
-	if(state.world.unilateral_relationship_get_military_access(url))
+	if(military::relationship_matrix::get(state.military_definitions.relationships.military_access, nation_as, controller))
 		return true;
 
 	if(military::are_allied_in_war(state, nation_as, controller))
@@ -1688,27 +1696,190 @@ struct province_and_distance {
 	}
 };
 
+struct retreat_province_and_distance {
+	float distance_covered = 0.0f;
+	dcon::province_id province;
+
+	bool operator<(retreat_province_and_distance const& other) const noexcept {
+		if(other.distance_covered != distance_covered)
+			return distance_covered > other.distance_covered;
+		return other.province.index() > province.index();
+	}
+};
+
+struct cluster_and_distance {
+	float distance_covered = 0.0f;
+	float distance_to_target = 0.0f;
+	dcon::state_definition_id cluster;
+
+	bool operator<(cluster_and_distance const& other) const noexcept {
+		if(other.distance_covered + other.distance_to_target != distance_covered + distance_to_target)
+			return distance_covered + distance_to_target > other.distance_covered + other.distance_to_target;
+		return other.cluster.index() > cluster.index();
+	}
+};
+
+// Scratch memory shared by the pathfinding functions below. There is one per thread, so that the ai can ask for paths
+// from parallel loops, and it is reused from one search to the next: an origin only counts when its generation stamp
+// matches the current search, which saves clearing the array, and the heaps keep their capacity.
+struct pathfinding_workspace {
+	std::vector<dcon::province_id> origins;
+	std::vector<uint32_t> generations;
+	std::vector<province_and_distance> heap;
+	std::vector<retreat_province_and_distance> retreat_heap;
+	uint32_t generation = 0;
+
+	// the same for searches over the state definition graph, plus the corridor those searches leave behind
+	std::vector<dcon::state_definition_id> cluster_origins;
+	std::vector<uint32_t> cluster_generations;
+	std::vector<uint32_t> corridor_generations;
+	std::vector<cluster_and_distance> cluster_heap;
+	uint32_t cluster_generation = 0;
+	uint32_t corridor_generation = 0;
+
+	// set by search_land_path when it had to ask whether the army could embark (see path_result_cache)
+	bool considered_embarking = false;
+
+	void begin_search(sys::state& state) {
+		auto size = state.world.province_size();
+		if(generations.size() < size) {
+			origins.resize(size);
+			generations.resize(size, 0);
+		}
+		++generation;
+		if(generation == 0) { // wrapped around: old stamps could be mistaken for current ones
+			std::fill(generations.begin(), generations.end(), 0);
+			generation = 1;
+		}
+		heap.clear();
+		retreat_heap.clear();
+	}
+	dcon::province_id get(dcon::province_id p) const {
+		return generations[p.index()] == generation ? origins[p.index()] : dcon::province_id{};
+	}
+	void set(dcon::province_id p, dcon::province_id origin) {
+		origins[p.index()] = origin;
+		generations[p.index()] = generation;
+	}
+
+	void begin_cluster_search(sys::state& state) {
+		auto size = state.world.state_definition_size();
+		if(cluster_generations.size() < size) {
+			cluster_origins.resize(size);
+			cluster_generations.resize(size, 0);
+			corridor_generations.resize(size, 0);
+		}
+		++cluster_generation;
+		++corridor_generation;
+		if(cluster_generation == 0 || corridor_generation == 0) {
+			std::fill(cluster_generations.begin(), cluster_generations.end(), 0);
+			std::fill(corridor_generations.begin(), corridor_generations.end(), 0);
+			cluster_generation = 1;
+			corridor_generation = 1;
+		}
+		cluster_heap.clear();
+	}
+	bool cluster_visited(dcon::state_definition_id c) const {
+		return cluster_generations[c.index()] == cluster_generation;
+	}
+	void set_cluster(dcon::state_definition_id c, dcon::state_definition_id origin) {
+		cluster_origins[c.index()] = origin;
+		cluster_generations[c.index()] = cluster_generation;
+	}
+	// provinces outside of any state definition (sea, wasteland) are never excluded
+	bool in_corridor(sys::state& state, dcon::province_id p) const {
+		auto c = state.world.province_get_state_from_abstract_state_membership(p);
+		return !c || corridor_generations[c.index()] == corridor_generation;
+	}
+};
+
+static thread_local pathfinding_workspace path_workspace;
+
+static bool cluster_is_passable(sys::state& state, dcon::state_definition_id c, dcon::nation_id nation_as) {
+	for(auto n : state.province_definitions.path_cluster_controllers[c.index()]) {
+		if(has_land_access_through_controller(state, nation_as, n))
+			return true;
+	}
+	return false;
+}
+
+// Searches the state definition graph for a route from the state of start to the state of end that only goes through
+// states where nation_as may enter at least one province. When one is found, the states along it and their neighbors
+// are marked as the corridor that the province level search is then limited to. Returns false when the search should
+// simply cover the whole map instead: sea or stateless endpoints, nearby endpoints, or no route between states.
+static bool mark_path_corridor(sys::state& state, dcon::province_id start, dcon::province_id end, dcon::nation_id nation_as) {
+	auto& pd = state.province_definitions;
+	if(pd.path_cluster_edges_start.empty())
+		return false;
+
+	auto start_cluster = state.world.province_get_state_from_abstract_state_membership(start);
+	auto end_cluster = state.world.province_get_state_from_abstract_state_membership(end);
+	if(!start_cluster || !end_cluster || start_cluster == end_cluster)
+		return false;
+	for(auto i = pd.path_cluster_edges_start[start_cluster.index()]; i < pd.path_cluster_edges_start[start_cluster.index() + 1]; ++i) {
+		if(pd.path_cluster_edges[i].to == end_cluster)
+			return false; // neighboring states: the flat search is cheap enough
+	}
+
+	auto& ws = path_workspace;
+	ws.begin_cluster_search(state);
+	auto& cluster_heap = ws.cluster_heap;
+	auto end_center = pd.path_cluster_center[end_cluster.index()];
+
+	ws.set_cluster(start_cluster, dcon::state_definition_id{});
+	cluster_heap.push_back(cluster_and_distance{ 0.0f, direct_distance(state, start, end), start_cluster });
+	while(cluster_heap.size() > 0) {
+		std::pop_heap(cluster_heap.begin(), cluster_heap.end());
+		auto nearest = cluster_heap.back();
+		cluster_heap.pop_back();
+
+		if(nearest.cluster == end_cluster) {
+			auto mark = [&](dcon::state_definition_id c) {
+				ws.corridor_generations[c.index()] = ws.corridor_generation;
+				for(auto i = pd.path_cluster_edges_start[c.index()]; i < pd.path_cluster_edges_start[c.index() + 1]; ++i)
+					ws.corridor_generations[pd.path_cluster_edges[i].to.index()] = ws.corridor_generation;
+			};
+			for(auto c = end_cluster; c; c = ws.cluster_origins[c.index()])
+				mark(c);
+			return true;
+		}
+
+		for(auto i = pd.path_cluster_edges_start[nearest.cluster.index()]; i < pd.path_cluster_edges_start[nearest.cluster.index() + 1]; ++i) {
+			auto& e = pd.path_cluster_edges[i];
+			if(!ws.cluster_visited(e.to)) {
+				if(e.to == end_cluster || cluster_is_passable(state, e.to, nation_as)) {
+					cluster_heap.push_back(cluster_and_distance{ nearest.distance_covered + e.cost, direct_distance(state, pd.path_cluster_center[e.to.index()], end_center), e.to });
+					std::push_heap(cluster_heap.begin(), cluster_heap.end());
+					ws.set_cluster(e.to, nearest.cluster);
+				} else {
+					ws.set_cluster(e.to, dcon::state_definition_id{}); // exclude it from being checked again
+				}
+			}
+		}
+	}
+	return false;
+}
+
 static void assert_path_result(std::vector<dcon::province_id>& v) {
 	for(auto const e : v)
 		assert(bool(e));
 }
 
-// normal pathfinding
-std::vector<dcon::province_id> make_land_path(sys::state& state, dcon::province_id start, dcon::province_id end, dcon::nation_id nation_as, dcon::army_id a) {
+static bool search_land_path(sys::state& state, dcon::province_id start, dcon::province_id end, dcon::nation_id nation_as, dcon::army_id a, std::vector<dcon::province_id>& path_result, bool corridor_only) {
+	path_result.clear();
 
-	std::vector<province_and_distance> path_heap;
-	auto origins_vector = ve::vectorizable_buffer<dcon::province_id, dcon::province_id>(state.world.province_size());
-
-	std::vector<dcon::province_id> path_result;
+	auto& ws = path_workspace;
+	ws.begin_search(state);
+	auto& path_heap = ws.heap;
 
 	if(start == end)
-		return path_result;
+		return false;
 
 	auto fill_path_result = [&](dcon::province_id i) {
 		path_result.push_back(end);
 		while(i && i != start) {
 			path_result.push_back(i);
-			i = origins_vector.get(i);
+			i = ws.get(i);
 		}
 	};
 
@@ -1724,30 +1895,31 @@ std::vector<dcon::province_id> make_land_path(sys::state& state, dcon::province_
 			auto bits = adj.get_type();
 			auto distance = adj.get_distance();
 
-			if((bits & province::border::impassible_bit) == 0 && !origins_vector.get(other_prov)) {
+			if((bits & province::border::impassible_bit) == 0 && !ws.get(other_prov)) {
 				if(other_prov == end) {
 					fill_path_result(nearest.province);
 					assert_path_result(path_result);
-					return path_result;
+					return true;
 				}
 
 				if(other_prov.id.index() < state.province_definitions.first_sea_province.index()) { // is land
-					if(has_access_to_province(state, nation_as, other_prov)) {
+					if((!corridor_only || ws.in_corridor(state, other_prov)) && has_access_to_province(state, nation_as, other_prov)) {
 						path_heap.push_back(
 								province_and_distance{nearest.distance_covered + distance, direct_distance(state, other_prov, end), other_prov});
 						std::push_heap(path_heap.begin(), path_heap.end());
-						origins_vector.set(other_prov, nearest.province);
+						ws.set(other_prov, nearest.province);
 					} else {
-						origins_vector.set(other_prov, dcon::province_id{0}); // exclude it from being checked again
+						ws.set(other_prov, dcon::province_id{0}); // exclude it from being checked again
 					}
 				} else { // is sea
+					ws.considered_embarking = true;
 					if(military::can_embark_onto_sea_tile(state, nation_as, other_prov, a)) {
 						path_heap.push_back(
 								province_and_distance{nearest.distance_covered + distance, direct_distance(state, other_prov, end), other_prov});
 						std::push_heap(path_heap.begin(), path_heap.end());
-						origins_vector.set(other_prov, nearest.province);
+						ws.set(other_prov, nearest.province);
 					} else {
-						origins_vector.set(other_prov, dcon::province_id{0}); // exclude it from being checked again
+						ws.set(other_prov, dcon::province_id{0}); // exclude it from being checked again
 					}
 				}
 			}
@@ -1755,24 +1927,24 @@ std::vector<dcon::province_id> make_land_path(sys::state& state, dcon::province_
 	}
 
 	assert_path_result(path_result);
-	return path_result;
+	return false;
 }
 
-std::vector<dcon::province_id> make_safe_land_path(sys::state& state, dcon::province_id start, dcon::province_id end, dcon::nation_id nation_as) {
+static bool search_safe_land_path(sys::state& state, dcon::province_id start, dcon::province_id end, dcon::nation_id nation_as, std::vector<dcon::province_id>& path_result, bool corridor_only) {
+	path_result.clear();
 
-	std::vector<province_and_distance> path_heap;
-	auto origins_vector = ve::vectorizable_buffer<dcon::province_id, dcon::province_id>(state.world.province_size());
-
-	std::vector<dcon::province_id> path_result;
+	auto& ws = path_workspace;
+	ws.begin_search(state);
+	auto& path_heap = ws.heap;
 
 	if(start == end)
-		return path_result;
+		return false;
 
 	auto fill_path_result = [&](dcon::province_id i) {
 		path_result.push_back(end);
 		while(i && i != start) {
 			path_result.push_back(i);
-			i = origins_vector.get(i);
+			i = ws.get(i);
 		}
 	};
 
@@ -1788,48 +1960,265 @@ std::vector<dcon::province_id> make_safe_land_path(sys::state& state, dcon::prov
 			auto bits = adj.get_type();
 			auto distance = adj.get_distance();
 
-			if((bits & province::border::impassible_bit) == 0 && !origins_vector.get(other_prov)) {
+			if((bits & province::border::impassible_bit) == 0 && !ws.get(other_prov)) {
 				if(other_prov == end) {
 					fill_path_result(nearest.province);
 					assert_path_result(path_result);
-					return path_result;
+					return true;
 				}
 
 				if(other_prov.id.index() < state.province_definitions.first_sea_province.index()) { // is land
-					if(other_prov.get_siege_progress() == 0 && has_safe_access_to_province(state, nation_as, other_prov)) {
+					if(other_prov.get_siege_progress() == 0 && (!corridor_only || ws.in_corridor(state, other_prov)) && has_safe_access_to_province(state, nation_as, other_prov)) {
 						path_heap.push_back(
 								province_and_distance{ nearest.distance_covered + distance, direct_distance(state, other_prov, end), other_prov });
 						std::push_heap(path_heap.begin(), path_heap.end());
-						origins_vector.set(other_prov, nearest.province);
+						ws.set(other_prov, nearest.province);
 					} else {
-						origins_vector.set(other_prov, dcon::province_id{0}); // exclude it from being checked again
+						ws.set(other_prov, dcon::province_id{0}); // exclude it from being checked again
 					}
 				} else { // is sea
-					origins_vector.set(other_prov, dcon::province_id{0}); // exclude it from being checked again
+					ws.set(other_prov, dcon::province_id{0}); // exclude it from being checked again
 				}
 			}
 		}
 	}
 
 	assert_path_result(path_result);
-	return path_result;
+	return false;
 }
 
-// used for rebel unit and black-flagged unit pathfinding
-std::vector<dcon::province_id> make_unowned_land_path(sys::state& state, dcon::province_id start, dcon::province_id end) {
-	std::vector<province_and_distance> path_heap;
-	auto origins_vector = ve::vectorizable_buffer<dcon::province_id, dcon::province_id>(state.world.province_size());
+void make_land_distance_field(sys::state& state, dcon::nation_id nation_as, std::vector<dcon::province_id> const& sources, land_distance_field& field_out) {
+	field_out.distance.assign(state.world.province_size(), std::numeric_limits<float>::infinity());
 
-	std::vector<dcon::province_id> path_result;
+	auto& path_heap = path_workspace.retreat_heap;
+	path_heap.clear();
+
+	for(auto p : sources) {
+		if(field_out.distance[p.index()] != 0.0f) {
+			field_out.distance[p.index()] = 0.0f;
+			path_heap.push_back(retreat_province_and_distance{ 0.0f, p });
+			std::push_heap(path_heap.begin(), path_heap.end());
+		}
+	}
+	while(path_heap.size() > 0) {
+		std::pop_heap(path_heap.begin(), path_heap.end());
+		auto nearest = path_heap.back();
+		path_heap.pop_back();
+
+		if(nearest.distance_covered > field_out.distance[nearest.province.index()])
+			continue; // already reached by a shorter route
+
+		for(auto adj : state.world.province_get_province_adjacency(nearest.province)) {
+			auto other_prov =
+				adj.get_connected_provinces(0) == nearest.province ? adj.get_connected_provinces(1) : adj.get_connected_provinces(0);
+			auto bits = adj.get_type();
+			auto new_distance = nearest.distance_covered + adj.get_distance();
+
+			if((bits & (province::border::impassible_bit | province::border::coastal_bit)) == 0
+				&& new_distance < field_out.distance[other_prov.id.index()]
+				&& has_access_to_province(state, nation_as, other_prov)) {
+
+				field_out.distance[other_prov.id.index()] = new_distance;
+				path_heap.push_back(retreat_province_and_distance{ new_distance, other_prov });
+				std::push_heap(path_heap.begin(), path_heap.end());
+			}
+		}
+	}
+}
+
+// Paths found by the land, unowned land and naval searches, kept per thread and dropped least recently used first. A
+// cached path is only handed back when a new search is certain to find the very same one, as the host and the clients
+// must keep making the same decisions. Changes of control (and canals opening) change the map epoch, which drops
+// everything. Land paths also depend on which controllers the nation may pass through, so they are further tied to the
+// access epoch of that nation, which changes when a war, military access, sphere or overlord changes what it may enter (see
+// invalidate_land_access).
+// Land searches that asked whether the army could embark depend on where fleets are, and are never cached.
+enum class path_kind : uint8_t { land, unowned_land, naval };
+
+struct path_cache_key {
+	dcon::province_id start;
+	dcon::province_id end;
+	dcon::nation_id nation;
+	path_kind kind = path_kind::land;
+
+	bool operator==(path_cache_key const& other) const noexcept {
+		return start == other.start && end == other.end && nation == other.nation && kind == other.kind;
+	}
+};
+
+struct path_cache_key_hash {
+	using is_avalanching = void;
+
+	auto operator()(path_cache_key const& k) const noexcept -> uint64_t {
+		uint64_t packed = (uint64_t(uint32_t(k.start.index() + 1)) << 40) ^ (uint64_t(uint32_t(k.end.index() + 1)) << 20)
+			^ (uint64_t(uint32_t(k.nation.index() + 1)) << 2) ^ uint64_t(k.kind);
+		return ankerl::unordered_dense::hash<uint64_t>()(packed);
+	}
+};
+
+struct path_cache_entry {
+	path_cache_key key;
+	uint64_t map_epoch = 0;
+	uint64_t access_epoch = 0;
+	std::vector<dcon::province_id> path;
+	int32_t newer = -1;
+	int32_t older = -1;
+};
+
+static std::atomic<uint64_t> path_cache_hits{ 0 };
+static std::atomic<uint64_t> path_cache_misses{ 0 };
+static std::atomic<uint64_t> path_map_epoch_counter{ 0 };
+
+struct path_result_cache {
+	static constexpr int32_t capacity = 2048;
+
+	std::vector<path_cache_entry> entries;
+	ankerl::unordered_dense::map<path_cache_key, int32_t, path_cache_key_hash> index;
+	int32_t newest = -1;
+	int32_t oldest = -1;
+
+	void unlink(int32_t i) {
+		auto& e = entries[i];
+		if(e.newer != -1)
+			entries[e.newer].older = e.older;
+		else
+			newest = e.older;
+		if(e.older != -1)
+			entries[e.older].newer = e.newer;
+		else
+			oldest = e.newer;
+		e.newer = -1;
+		e.older = -1;
+	}
+	void make_newest(int32_t i) {
+		entries[i].older = newest;
+		if(newest != -1)
+			entries[newest].newer = i;
+		newest = i;
+		if(oldest == -1)
+			oldest = i;
+	}
+
+	bool fetch(path_cache_key const& key, uint64_t map_epoch, uint64_t access_epoch, std::vector<dcon::province_id>& path_out) {
+		if(auto it = index.find(key); it != index.end()) {
+			auto& e = entries[it->second];
+			if(e.map_epoch == map_epoch && e.access_epoch == access_epoch) {
+				path_out.assign(e.path.begin(), e.path.end());
+				unlink(it->second);
+				make_newest(it->second);
+				path_cache_hits.fetch_add(1, std::memory_order_relaxed);
+				return true;
+			}
+		}
+		path_cache_misses.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+	void store(path_cache_key const& key, uint64_t map_epoch, uint64_t access_epoch, std::vector<dcon::province_id> const& path) {
+		int32_t i = -1;
+		if(auto it = index.find(key); it != index.end()) {
+			i = it->second;
+			unlink(i);
+		} else if(int32_t(entries.size()) < capacity) {
+			i = int32_t(entries.size());
+			entries.emplace_back();
+			index.insert_or_assign(key, i);
+		} else {
+			i = oldest;
+			unlink(i);
+			index.erase(entries[i].key);
+			index.insert_or_assign(key, i);
+		}
+		auto& e = entries[i];
+		e.key = key;
+		e.map_epoch = map_epoch;
+		e.access_epoch = access_epoch;
+		e.path.assign(path.begin(), path.end());
+		make_newest(i);
+	}
+};
+
+static thread_local path_result_cache path_cache;
+
+void invalidate_path_cache(sys::state& state) {
+	// taken from a counter shared by all states, so that a cache that served another state never sees a matching epoch
+	state.province_definitions.path_map_epoch = path_map_epoch_counter.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+void invalidate_land_access(sys::state& state, dcon::nation_id n) {
+	if(!n)
+		return;
+	auto& epochs = state.province_definitions.path_access_epochs;
+	if(epochs.size() <= size_t(n.index()))
+		epochs.resize(n.index() + 1, 0);
+	epochs[n.index()] = path_map_epoch_counter.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+void invalidate_land_access(sys::state& state) {
+	auto& epochs = state.province_definitions.path_access_epochs;
+	epochs.resize(state.world.nation_size());
+	std::fill(epochs.begin(), epochs.end(), path_map_epoch_counter.fetch_add(1, std::memory_order_relaxed) + 1);
+}
+
+static uint64_t land_access_epoch(sys::state& state, dcon::nation_id n) {
+	if(!n)
+		return 0; // rebels go everywhere
+	auto& epochs = state.province_definitions.path_access_epochs;
+	return size_t(n.index()) < epochs.size() ? epochs[n.index()] : 0;
+}
+
+path_cache_statistics get_path_cache_statistics() {
+	return path_cache_statistics{ path_cache_hits.load(std::memory_order_relaxed), path_cache_misses.load(std::memory_order_relaxed) };
+}
+
+// Long paths are first looked for within the corridor of states found by mark_path_corridor, which keeps the search
+// from flooding whole continents; if that fails the whole map is searched, so the corridor never makes a path impossible.
+
+// normal pathfinding
+static bool search_land_path_with_corridor(sys::state& state, dcon::province_id start, dcon::province_id end, dcon::nation_id nation_as, dcon::army_id a, std::vector<dcon::province_id>& path_result) {
+	if(mark_path_corridor(state, start, end, nation_as) && search_land_path(state, start, end, nation_as, a, path_result, true))
+		return true;
+	return search_land_path(state, start, end, nation_as, a, path_result, false);
+}
+
+bool make_land_path(sys::state& state, dcon::province_id start, dcon::province_id end, dcon::nation_id nation_as, dcon::army_id a, std::vector<dcon::province_id>& path_result) {
+	auto map_epoch = state.province_definitions.path_map_epoch;
+	if(start == end || map_epoch == 0) {
+		return search_land_path_with_corridor(state, start, end, nation_as, a, path_result);
+	}
+
+	path_cache_key key{ start, end, nation_as, path_kind::land };
+	auto access_epoch = land_access_epoch(state, nation_as);
+	if(path_cache.fetch(key, map_epoch, access_epoch, path_result))
+		return !path_result.empty();
+
+	path_workspace.considered_embarking = false;
+	auto found = search_land_path_with_corridor(state, start, end, nation_as, a, path_result);
+	if(!path_workspace.considered_embarking)
+		path_cache.store(key, map_epoch, access_epoch, path_result);
+	return found;
+}
+
+bool make_safe_land_path(sys::state& state, dcon::province_id start, dcon::province_id end, dcon::nation_id nation_as, std::vector<dcon::province_id>& path_result) {
+	if(mark_path_corridor(state, start, end, nation_as) && search_safe_land_path(state, start, end, nation_as, path_result, true))
+		return true;
+	return search_safe_land_path(state, start, end, nation_as, path_result, false);
+}
+
+static bool search_unowned_land_path(sys::state& state, dcon::province_id start, dcon::province_id end, std::vector<dcon::province_id>& path_result) {
+	path_result.clear();
+
+	auto& ws = path_workspace;
+	ws.begin_search(state);
+	auto& path_heap = ws.heap;
 
 	if(start == end)
-		return path_result;
+		return false;
 
 	auto fill_path_result = [&](dcon::province_id i) {
 		path_result.push_back(end);
 		while(i && i != start) {
 			path_result.push_back(i);
-			i = origins_vector.get(i);
+			i = ws.get(i);
 		}
 	};
 
@@ -1845,42 +2234,41 @@ std::vector<dcon::province_id> make_unowned_land_path(sys::state& state, dcon::p
 			auto bits = adj.get_type();
 			auto distance = adj.get_distance();
 
-			if((bits & province::border::impassible_bit) == 0 && !origins_vector.get(other_prov)) {
+			if((bits & province::border::impassible_bit) == 0 && !ws.get(other_prov)) {
 				if(other_prov == end) {
 					fill_path_result(nearest.province);
 					assert_path_result(path_result);
-					return path_result;
+					return true;
 				}
 				if((bits & province::border::coastal_bit) == 0) { // doesn't cross coast -- i.e. is land province
 					path_heap.push_back(
 							province_and_distance{nearest.distance_covered + distance, direct_distance(state, other_prov, end), other_prov});
 					std::push_heap(path_heap.begin(), path_heap.end());
-					origins_vector.set(other_prov, nearest.province);
+					ws.set(other_prov, nearest.province);
 				}
 			}
 		}
 	}
 
 	assert_path_result(path_result);
-	return path_result;
+	return false;
 }
 
-// naval unit pathfinding; start and end provinces may be land provinces; function assumes you have naval access to both
-std::vector<dcon::province_id> make_naval_path(sys::state& state, dcon::province_id start, dcon::province_id end) {
-
-	std::vector<province_and_distance> path_heap;
-	auto origins_vector = ve::vectorizable_buffer<dcon::province_id, dcon::province_id>(state.world.province_size());
+static bool search_naval_path(sys::state& state, dcon::province_id start, dcon::province_id end, std::vector<dcon::province_id>& path_result) {
+	path_result.clear();
 
-	std::vector<dcon::province_id> path_result;
+	auto& ws = path_workspace;
+	ws.begin_search(state);
+	auto& path_heap = ws.heap;
 
 	if(start == end)
-		return path_result;
+		return false;
 
 	auto fill_path_result = [&](dcon::province_id i) {
 		path_result.push_back(end);
 		while(i && i != start) {
 			path_result.push_back(i);
-			i = origins_vector.get(i);
+			i = ws.get(i);
 		}
 	};
 
@@ -1897,7 +2285,7 @@ std::vector<dcon::province_id> make_naval_path(sys::state& state, dcon::province
 			auto distance = adj.get_distance();
 
 			// can't move over impassible connections; can't move directly from port to port
-			if((bits & province::border::impassible_bit) == 0 && !origins_vector.get(other_prov) &&
+			if((bits & province::border::impassible_bit) == 0 && !ws.get(other_prov) &&
 					(other_prov.id.index() >= state.province_definitions.first_sea_province.index() ||
 							nearest.province.index() >= state.province_definitions.first_sea_province.index())) {
 
@@ -1907,28 +2295,28 @@ std::vector<dcon::province_id> make_naval_path(sys::state& state, dcon::province
 					if(other_prov == end) {
 						fill_path_result(nearest.province);
 						assert_path_result(path_result);
-						return path_result;
+						return true;
 					} else {
 
 						path_heap.push_back(province_and_distance{ nearest.distance_covered + distance, direct_distance(state, other_prov, end), other_prov });
 						std::push_heap(path_heap.begin(), path_heap.end());
-						origins_vector.set(other_prov, nearest.province);
+						ws.set(other_prov, nearest.province);
 					}
 				} else if(other_prov.id.index() < state.province_definitions.first_sea_province.index() && other_prov == end && other_prov.get_port_to() == nearest.province) { // case: ending in a port
 
 					fill_path_result(nearest.province);
 					assert_path_result(path_result);
-					return path_result;
+					return true;
 				} else if(nearest.province.index() < state.province_definitions.first_sea_province.index() && state.world.province_get_port_to(nearest.province) == other_prov.id) { // case: leaving port
 
 					if(other_prov == end) {
 						fill_path_result(nearest.province);
 						assert_path_result(path_result);
-						return path_result;
+						return true;
 					} else {
 						path_heap.push_back(province_and_distance{ nearest.distance_covered + distance, direct_distance(state, other_prov, end), other_prov });
 						std::push_heap(path_heap.begin(), path_heap.end());
-						origins_vector.set(other_prov, nearest.province);
+						ws.set(other_prov, nearest.province);
 					}
 				}
 			}
@@ -1936,31 +2324,48 @@ std::vector<dcon::province_id> make_naval_path(sys::state& state, dcon::province
 	}
 
 	assert_path_result(path_result);
-	return path_result;
+	return false;
 }
 
-struct retreat_province_and_distance {
-	float distance_covered = 0.0f;
-	dcon::province_id province;
+// used for rebel unit and black-flagged unit pathfinding
+bool make_unowned_land_path(sys::state& state, dcon::province_id start, dcon::province_id end, std::vector<dcon::province_id>& path_result) {
+	auto map_epoch = state.province_definitions.path_map_epoch;
+	if(start == end || map_epoch == 0)
+		return search_unowned_land_path(state, start, end, path_result);
 
-	bool operator<(retreat_province_and_distance const& other) const noexcept {
-		if(other.distance_covered != distance_covered)
-			return distance_covered > other.distance_covered;
-		return other.province.index() > province.index();
-	}
-};
+	path_cache_key key{ start, end, dcon::nation_id{}, path_kind::unowned_land };
+	if(path_cache.fetch(key, map_epoch, 0, path_result))
+		return !path_result.empty();
+	auto found = search_unowned_land_path(state, start, end, path_result);
+	path_cache.store(key, map_epoch, 0, path_result);
+	return found;
+}
 
-std::vector<dcon::province_id> make_naval_retreat_path(sys::state& state, dcon::nation_id nation_as, dcon::province_id start) {
+// naval unit pathfinding; start and end provinces may be land provinces; function assumes you have naval access to both
+bool make_naval_path(sys::state& state, dcon::province_id start, dcon::province_id end, std::vector<dcon::province_id>& path_result) {
+	auto map_epoch = state.province_definitions.path_map_epoch;
+	if(start == end || map_epoch == 0)
+		return search_naval_path(state, start, end, path_result);
 
-	std::vector<retreat_province_and_distance> path_heap;
-	auto origins_vector = ve::vectorizable_buffer<dcon::province_id, dcon::province_id>(state.world.province_size());
+	path_cache_key key{ start, end, dcon::nation_id{}, path_kind::naval };
+	if(path_cache.fetch(key, map_epoch, 0, path_result))
+		return !path_result.empty();
+	auto found = search_naval_path(state, start, end, path_result);
+	path_cache.store(key, map_epoch, 0, path_result);
+	return found;
+}
 
-	std::vector<dcon::province_id> path_result;
+bool make_naval_retreat_path(sys::state& state, dcon::nation_id nation_as, dcon::province_id start, std::vector<dcon::province_id>& path_result) {
+	path_result.clear();
+
+	auto& ws = path_workspace;
+	ws.begin_search(state);
+	auto& path_heap = ws.retreat_heap;
 
 	auto fill_path_result = [&](dcon::province_id i) {
 		while(i && i != start) {
 			path_result.push_back(i);
-			i = origins_vector.get(i);
+			i = ws.get(i);
 		}
 	};
 
@@ -1973,7 +2378,7 @@ std::vector<dcon::province_id> make_naval_retreat_path(sys::state& state, dcon::
 		if(nearest.province.index() < state.province_definitions.first_sea_province.index()) {
 			fill_path_result(nearest.province);
 			assert_path_result(path_result);
-			return path_result;
+			return !path_result.empty();
 		}
 
 		for(auto adj : state.world.province_get_province_adjacency(nearest.province)) {
@@ -1982,41 +2387,41 @@ std::vector<dcon::province_id> make_naval_retreat_path(sys::state& state, dcon::
 			auto bits = adj.get_type();
 			auto distance = adj.get_distance();
 
-			if((bits & province::border::impassible_bit) == 0 && !origins_vector.get(other_prov)) {
+			if((bits & province::border::impassible_bit) == 0 && !ws.get(other_prov)) {
 				if((bits & province::border::coastal_bit) == 0) { // doesn't cross coast -- i.e. is sea province
 					path_heap.push_back(retreat_province_and_distance{ nearest.distance_covered + distance, other_prov });
 					std::push_heap(path_heap.begin(), path_heap.end());
-					origins_vector.set(other_prov, nearest.province);
+					ws.set(other_prov, nearest.province);
 				} else if(other_prov.get_port_to() != nearest.province) { // province is not connected by a port here
 					// skip
 				} else if(has_naval_access_to_province(state, nation_as, other_prov)) { // possible land province destination
 					path_heap.push_back(retreat_province_and_distance{nearest.distance_covered + distance, other_prov});
 					std::push_heap(path_heap.begin(), path_heap.end());
-					origins_vector.set(other_prov, nearest.province);
+					ws.set(other_prov, nearest.province);
 				} else {  // impossible land province destination
-					origins_vector.set(other_prov, dcon::province_id{0}); // valid province prevents rechecks
+					ws.set(other_prov, dcon::province_id{0}); // valid province prevents rechecks
 				}
 			}
 		}
 	}
 
 	assert_path_result(path_result);
-	return path_result;
+	return false;
 }
 
-std::vector<dcon::province_id> make_land_retreat_path(sys::state& state, dcon::nation_id nation_as, dcon::province_id start) {
-
-	std::vector<retreat_province_and_distance> path_heap;
-	auto origins_vector = ve::vectorizable_buffer<dcon::province_id, dcon::province_id>(state.world.province_size());
+bool make_land_retreat_path(sys::state& state, dcon::nation_id nation_as, dcon::province_id start, std::vector<dcon::province_id>& path_result) {
+	path_result.clear();
 
-	origins_vector.set(start, dcon::province_id{0});
+	auto& ws = path_workspace;
+	ws.begin_search(state);
+	auto& path_heap = ws.retreat_heap;
 
-	std::vector<dcon::province_id> path_result;
+	ws.set(start, dcon::province_id{0});
 
 	auto fill_path_result = [&](dcon::province_id i) {
 		while(i && i != start) {
 			path_result.push_back(i);
-			i = origins_vector.get(i);
+			i = ws.get(i);
 		}
 	};
 
@@ -2029,7 +2434,7 @@ std::vector<dcon::province_id> make_land_retreat_path(sys::state& state, dcon::n
 		if(nearest.province != start && has_naval_access_to_province(state, nation_as, nearest.province)) {
 			fill_path_result(nearest.province);
 			assert_path_result(path_result);
-			return path_result;
+			return !path_result.empty();
 		}
 
 		for(auto adj : state.world.province_get_province_adjacency(nearest.province)) {
@@ -2038,11 +2443,11 @@ std::vector<dcon::province_id> make_land_retreat_path(sys::state& state, dcon::n
 			auto bits = adj.get_type();
 			auto distance = adj.get_distance();
 
-			if((bits & province::border::impassible_bit) == 0 && !origins_vector.get(other_prov)) {
+			if((bits & province::border::impassible_bit) == 0 && !ws.get(other_prov)) {
 				if((bits & province::border::coastal_bit) == 0) { // doesn't cross coast -- i.e. is land province
 					path_heap.push_back(retreat_province_and_distance{nearest.distance_covered + distance, other_prov});
 					std::push_heap(path_heap.begin(), path_heap.end());
-					origins_vector.set(other_prov, nearest.province);
+					ws.set(other_prov, nearest.province);
 				} else { // is sea province
 								 // nothing
 				}
@@ -2051,21 +2456,22 @@ std::vector<dcon::province_id> make_land_retreat_path(sys::state& state, dcon::n
 	}
 
 	assert_path_result(path_result);
-	return path_result;
+	return false;
 }
 
-std::vector<dcon::province_id> make_path_to_nearest_coast(sys::state& state, dcon::nation_id nation_as, dcon::province_id start) {
-	std::vector<retreat_province_and_distance> path_heap;
-	auto origins_vector = ve::vectorizable_buffer<dcon::province_id, dcon::province_id>(state.world.province_size());
+bool make_path_to_nearest_coast(sys::state& state, dcon::nation_id nation_as, dcon::province_id start, std::vector<dcon::province_id>& path_result) {
+	path_result.clear();
 
-	origins_vector.set(start, dcon::province_id{0});
+	auto& ws = path_workspace;
+	ws.begin_search(state);
+	auto& path_heap = ws.retreat_heap;
 
-	std::vector<dcon::province_id> path_result;
+	ws.set(start, dcon::province_id{0});
 
 	auto fill_path_result = [&](dcon::province_id i) {
 		while(i && i != start) {
 			path_result.push_back(i);
-			i = origins_vector.get(i);
+			i = ws.get(i);
 		}
 	};
 
@@ -2078,7 +2484,7 @@ std::vector<dcon::province_id> make_path_to_nearest_coast(sys::state& state, dco
 		if(state.world.province_get_is_coast(nearest.province)) {
 			fill_path_result(nearest.province);
 			assert_path_result(path_result);
-			return path_result;
+			return !path_result.empty();
 		}
 
 		for(auto adj : state.world.province_get_province_adjacency(nearest.province)) {
@@ -2087,14 +2493,14 @@ std::vector<dcon::province_id> make_path_to_nearest_coast(sys::state& state, dco
 			auto bits = adj.get_type();
 			auto distance = adj.get_distance();
 
-			if((bits & province::border::impassible_bit) == 0 && !origins_vector.get(other_prov)) {
+			if((bits & province::border::impassible_bit) == 0 && !ws.get(other_prov)) {
 				if((bits & province::border::coastal_bit) == 0) { // doesn't cross coast -- i.e. is land province
 					if(has_naval_access_to_province(state, nation_as, other_prov)) {
 						path_heap.push_back(retreat_province_and_distance{ nearest.distance_covered + distance, other_prov });
 						std::push_heap(path_heap.begin(), path_heap.end());
-						origins_vector.set(other_prov, nearest.province);
+						ws.set(other_prov, nearest.province);
 					} else {
-						origins_vector.set(other_prov, dcon::province_id{0});
+						ws.set(other_prov, dcon::province_id{0});
 					}
 				} else { // is sea province
 					// nothing
@@ -2104,20 +2510,21 @@ std::vector<dcon::province_id> make_path_to_nearest_coast(sys::state& state, dco
 	}
 
 	assert_path_result(path_result);
-	return path_result;
+	return false;
 }
-std::vector<dcon::province_id> make_unowned_path_to_nearest_coast(sys::state& state, dcon::province_id start) {
-	std::vector<retreat_province_and_distance> path_heap;
-	auto origins_vector = ve::vectorizable_buffer<dcon::province_id, dcon::province_id>(state.world.province_size());
+bool make_unowned_path_to_nearest_coast(sys::state& state, dcon::province_id start, std::vector<dcon::province_id>& path_result) {
+	path_result.clear();
 
-	origins_vector.set(start, dcon::province_id{0});
+	auto& ws = path_workspace;
+	ws.begin_search(state);
+	auto& path_heap = ws.retreat_heap;
 
-	std::vector<dcon::province_id> path_result;
+	ws.set(start, dcon::province_id{0});
 
 	auto fill_path_result = [&](dcon::province_id i) {
 		while(i && i != start) {
 			path_result.push_back(i);
-			i = origins_vector.get(i);
+			i = ws.get(i);
 		}
 	};
 
@@ -2130,7 +2537,7 @@ std::vector<dcon::province_id> make_unowned_path_to_nearest_coast(sys::state& st
 		if(state.world.province_get_is_coast(nearest.province)) {
 			fill_path_result(nearest.province);
 			assert_path_result(path_result);
-			return path_result;
+			return !path_result.empty();
 		}
 
 		for(auto adj : state.world.province_get_province_adjacency(nearest.province)) {
@@ -2139,11 +2546,11 @@ std::vector<dcon::province_id> make_unowned_path_to_nearest_coast(sys::state& st
 			auto bits = adj.get_type();
 			auto distance = adj.get_distance();
 
-			if((bits & province::border::impassible_bit) == 0 && !origins_vector.get(other_prov)) {
+			if((bits & province::border::impassible_bit) == 0 && !ws.get(other_prov)) {
 				if((bits & province::border::coastal_bit) == 0) { // doesn't cross coast -- i.e. is land province
 					path_heap.push_back(retreat_province_and_distance{ nearest.distance_covered + distance, other_prov });
 					std::push_heap(path_heap.begin(), path_heap.end());
-					origins_vector.set(other_prov, nearest.province);
+					ws.set(other_prov, nearest.province);
 				} else { // is sea province
 					// nothing
 				}
@@ -2152,6 +2559,47 @@ std::vector<dcon::province_id> make_unowned_path_to_nearest_coast(sys::state& st
 	}
 
 	assert_path_result(path_result);
+	return false;
+}
+
+std::vector<dcon::province_id> make_land_path(sys::state& state, dcon::province_id start, dcon::province_id end, dcon::nation_id nation_as, dcon::army_id a) {
+	std::vector<dcon::province_id> path_result;
+	make_land_path(state, start, end, nation_as, a, path_result);
+	return path_result;
+}
+std::vector<dcon::province_id> make_safe_land_path(sys::state& state, dcon::province_id start, dcon::province_id end, dcon::nation_id nation_as) {
+	std::vector<dcon::province_id> path_result;
+	make_safe_land_path(state, start, end, nation_as, path_result);
+	return path_result;
+}
+std::vector<dcon::province_id> make_unowned_land_path(sys::state& state, dcon::province_id start, dcon::province_id end) {
+	std::vector<dcon::province_id> path_result;
+	make_unowned_land_path(state, start, end, path_result);
+	return path_result;
+}
+std::vector<dcon::province_id> make_naval_path(sys::state& state, dcon::province_id start, dcon::province_id end) {
+	std::vector<dcon::province_id> path_result;
+	make_naval_path(state, start, end, path_result);
+	return path_result;
+}
+std::vector<dcon::province_id> make_naval_retreat_path(sys::state& state, dcon::nation_id nation_as, dcon::province_id start) {
+	std::vector<dcon::province_id> path_result;
+	make_naval_retreat_path(state, nation_as, start, path_result);
+	return path_result;
+}
+std::vector<dcon::province_id> make_land_retreat_path(sys::state& state, dcon::nation_id nation_as, dcon::province_id start) {
+	std::vector<dcon::province_id> path_result;
+	make_land_retreat_path(state, nation_as, start, path_result);
+	return path_result;
+}
+std::vector<dcon::province_id> make_path_to_nearest_coast(sys::state& state, dcon::nation_id nation_as, dcon::province_id start) {
+	std::vector<dcon::province_id> path_result;
+	make_path_to_nearest_coast(state, nation_as, start, path_result);
+	return path_result;
+}
+std::vector<dcon::province_id> make_unowned_path_to_nearest_coast(sys::state& state, dcon::province_id start) {
+	std::vector<dcon::province_id> path_result;
+	make_unowned_path_to_nearest_coast(state, start, path_result);
 	return path_result;
 }
 
@@ -2178,4 +2626,86 @@ void restore_distances(sys::state& state) {
 	}
 }
 
+void build_path_clusters(sys::state& state) {
+	invalidate_path_cache(state);
+
+	auto& pd = state.province_definitions;
+	auto cluster_count = state.world.state_definition_size();
+
+	// the center of a state is the province closest to the average of its provinces' positions
+	pd.path_cluster_center.assign(cluster_count, dcon::province_id{});
+	for(auto sd : state.world.in_state_definition) {
+		glm::vec3 sum{ 0.0f, 0.0f, 0.0f };
+		for(auto m : sd.get_abstract_state_membership())
+			sum += m.get_province().get_mid_point_b();
+		float best = -2.0f;
+		for(auto m : sd.get_abstract_state_membership()) {
+			auto pos = m.get_province().get_mid_point_b();
+			auto dot = (pos.x * sum.x + pos.y * sum.y) + pos.z * sum.z;
+			if(dot > best) {
+				best = dot;
+				pd.path_cluster_center[sd.id.index()] = m.get_province();
+			}
+		}
+	}
+
+	// edge costs go from center to center across the cheapest passable land border
+	std::vector<std::vector<path_cluster_edge>> edges(cluster_count);
+	for(int32_t i = 0; i < state.province_definitions.first_sea_province.index(); ++i) {
+		dcon::province_id p{ dcon::province_id::value_base_t(i) };
+		auto from = state.world.province_get_state_from_abstract_state_membership(p);
+		if(!from)
+			continue;
+		for(auto adj : state.world.province_get_province_adjacency(p)) {
+			if((adj.get_type() & (province::border::coastal_bit | province::border::impassible_bit)) != 0)
+				continue;
+			auto other = adj.get_connected_provinces(0) == p ? adj.get_connected_provinces(1) : adj.get_connected_provinces(0);
+			auto to = other.get_state_from_abstract_state_membership();
+			if(!to || to == from)
+				continue;
+			auto cost = direct_distance(state, pd.path_cluster_center[from.index()], p) + adj.get_distance() + direct_distance(state, other, pd.path_cluster_center[to.id.index()]);
+			auto& list = edges[from.index()];
+			auto it = std::find_if(list.begin(), list.end(), [&](path_cluster_edge const& e) { return e.to == to.id; });
+			if(it == list.end())
+				list.push_back(path_cluster_edge{ to.id, cost });
+			else
+				it->cost = std::min(it->cost, cost);
+		}
+	}
+	pd.path_cluster_edges_start.resize(cluster_count + 1);
+	pd.path_cluster_edges.clear();
+	for(uint32_t i = 0; i < cluster_count; ++i) {
+		pd.path_cluster_edges_start[i] = uint32_t(pd.path_cluster_edges.size());
+		pd.path_cluster_edges.insert(pd.path_cluster_edges.end(), edges[i].begin(), edges[i].end());
+	}
+	pd.path_cluster_edges_start[cluster_count] = uint32_t(pd.path_cluster_edges.size());
+
+	pd.path_cluster_controllers.resize(cluster_count);
+	for(auto sd : state.world.in_state_definition) {
+		auto& list = pd.path_cluster_controllers[sd.id.index()];
+		list.clear();
+		for(auto m : sd.get_abstract_state_membership()) {
+			auto c = m.get_province().get_nation_from_province_control().id;
+			if(std::find(list.begin(), list.end(), c) == list.end())
+				list.push_back(c);
+		}
+	}
+}
+
+// only the state of p is affected, so only its controller list is recomputed
+void update_path_cluster_controllers(sys::state& state, dcon::province_id p) {
+	invalidate_path_cache(state);
+
+	auto sd = state.world.province_get_state_from_abstract_state_membership(p);
+	if(!sd || state.province_definitions.path_cluster_controllers.size() <= size_t(sd.index()))
+		return;
+	auto& list = state.province_definitions.path_cluster_controllers[sd.index()];
+	list.clear();
+	for(auto m : state.world.state_definition_get_abstract_state_membership(sd)) {
+		auto c = m.get_province().get_nation_from_province_control().id;
+		if(std::find(list.begin(), list.end(), c) == list.end())
+			list.push_back(c);
+	}
+}
+
 } // namespace province
@@ -2,6 +2,7 @@
 
 #include "dcon_generated.hpp"
 #include "constants.hpp"
+#include <limits>
 
 namespace province {
 
@@ -17,11 +18,24 @@ inline constexpr dcon::province_id from_map_id(uint16_t id) {
 		return dcon::province_id(id - 1);
 }
 
+struct path_cluster_edge {
+	dcon::state_definition_id to;
+	float cost = 0.0f; // from the center of one state, across the cheapest border, to the center of the other
+};
+
 struct global_provincial_state {
 	std::vector<dcon::province_adjacency_id> canals;
 	ankerl::unordered_dense::map<dcon::modifier_id, dcon::gfx_object_id, sys::modifier_hash> terrain_to_gfx_map;
 	std::vector<bool> connected_region_is_coastal;
 
+	// abstract graph over state definitions, used to narrow long land path searches (see make_land_path)
+	std::vector<uint32_t> path_cluster_edges_start; // per state definition, plus one at the end
+	std::vector<path_cluster_edge> path_cluster_edges;
+	std::vector<dcon::province_id> path_cluster_center;
+	std::vector<std::vector<dcon::nation_id>> path_cluster_controllers; // distinct controllers of the land provinces
+	uint64_t path_map_epoch = 0; // changes whenever cached paths may have become wrong; 0 means nothing is cached
+	std::vector<uint64_t> path_access_epochs; // per nation: changes whenever it may have gained or lost access through another's land
+
 	dcon::province_id first_sea_province;
 	dcon::modifier_id europe;
 	dcon::modifier_id asia;
@@ -46,6 +60,11 @@ void update_cached_values(sys::state& state);
 void update_blockaded_cache(sys::state& state);
 void restore_unsaved_values(sys::state& state);
 void restore_distances(sys::state& state);
+void build_path_clusters(sys::state& state); // must run after restore_distances, and again whenever an adjacency opens or closes
+void update_path_cluster_controllers(sys::state& state, dcon::province_id p); // when the controller of p changes
+void invalidate_path_cache(sys::state& state); // when the map itself changes; control changes already do this
+void invalidate_land_access(sys::state& state, dcon::nation_id n); // when n may have gained or lost access through some land (war, military access, sphere, overlord)
+void invalidate_land_access(sys::state& state); // the same, for every nation
 
 template<typename T>
 auto is_overseas(sys::state const& state, T ids);
@@ -143,6 +162,46 @@ std::vector<dcon::province_id> make_land_retreat_path(sys::state& state, dcon::n
 std::vector<dcon::province_id> make_path_to_nearest_coast(sys::state& state, dcon::nation_id nation_as, dcon::province_id start);
 std::vector<dcon::province_id> make_unowned_path_to_nearest_coast(sys::state& state, dcon::province_id start);
 
+// the same searches, writing the path (last step first, as above) into a caller-provided buffer, which is cleared first;
+// callers that ask for many paths can reuse one buffer, and the search itself does not allocate once warmed up.
+// These return whether a (non-empty) path was found
+bool make_land_path(sys::state& state, dcon::province_id start, dcon::province_id end, dcon::nation_id nation_as, dcon::army_id a, std::vector<dcon::province_id>& path_out);
+bool make_safe_land_path(sys::state& state, dcon::province_id start, dcon::province_id end, dcon::nation_id nation_as, std::vector<dcon::province_id>& path_out);
+bool make_unowned_land_path(sys::state& state, dcon::province_id start, dcon::province_id end, std::vector<dcon::province_id>& path_out);
+bool make_naval_path(sys::state& state, dcon::province_id start, dcon::province_id end, std::vector<dcon::province_id>& path_out);
+bool make_naval_retreat_path(sys::state& state, dcon::nation_id nation_as, dcon::province_id start, std::vector<dcon::province_id>& path_out);
+bool make_land_retreat_path(sys::state& state, dcon::nation_id nation_as, dcon::province_id start, std::vector<dcon::province_id>& path_out);
+bool make_path_to_nearest_coast(sys::state& state, dcon::nation_id nation_as, dcon::province_id start, std::vector<dcon::province_id>& path_out);
+bool make_unowned_path_to_nearest_coast(sys::state& state, dcon::province_id start, std::vector<dcon::province_id>& path_out);
+
+// Travel distances over land from the nearest of several source provinces to every province, entering only provinces
+// that nation_as has access to (as make_land_path does, but without embarking). Built once, it answers "how far is
+// this province from the closest of these armies" for any province, instead of one search per army and target.
+// Unreachable provinces are left at infinity; the field's memory is reused when it is passed in again
+struct land_distance_field {
+	std::vector<float> distance;
+
+	float get(dcon::province_id p) const {
+		return distance[p.index()];
+	}
+	bool is_reachable(dcon::province_id p) const {
+		return distance[p.index()] != std::numeric_limits<float>::infinity();
+	}
+};
+void make_land_distance_field(sys::state& state, dcon::nation_id nation_as, std::vector<dcon::province_id> const& sources, land_distance_field& field_out);
+
+// make_land_path, make_unowned_land_path and make_naval_path hand back earlier results while they are still valid;
+// these are the totals over all threads since the program started
+struct path_cache_statistics {
+	uint64_t hits = 0;
+	uint64_t misses = 0;
+
+	float hit_rate() const {
+		return hits + misses > 0 ? float(hits) / float(hits + misses) : 0.0f;
+	}
+};
+path_cache_statistics get_path_cache_statistics();
+
 void set_province_controller(sys::state& state, dcon::province_id p, dcon::nation_id n);
 void set_province_controller(sys::state& state, dcon::province_id p, dcon::rebel_faction_id rf);
 
@@ -2570,6 +2570,7 @@ uint32_t ef_release_vassal(EFFECT_PARAMTERS) {
 		if(ws.world.nation_get_owned_province_count(holder) == 0)
 			return 0;
 		ws.world.force_create_overlord(holder, trigger::to_nation(primary_slot));
+		province::invalidate_land_access(ws, trigger::to_nation(primary_slot));
 		if(ws.world.nation_get_is_great_power(trigger::to_nation(primary_slot))) {
 			auto sr = ws.world.force_create_gp_relationship(holder, trigger::to_nation(primary_slot));
 			auto& flags = ws.world.gp_relationship_get_status(sr);
@@ -2592,6 +2593,7 @@ uint32_t ef_release_vassal_this_nation(EFFECT_PARAMTERS) {
 		if(ws.world.nation_get_owned_province_count(trigger::to_nation(this_slot)) == 0)
 			return 0;
 		ws.world.force_create_overlord(trigger::to_nation(this_slot), trigger::to_nation(primary_slot));
+		province::invalidate_land_access(ws, trigger::to_nation(primary_slot));
 		if(ws.world.nation_get_is_great_power(trigger::to_nation(primary_slot))) {
 			auto sr = ws.world.force_create_gp_relationship(trigger::to_nation(this_slot), trigger::to_nation(primary_slot));
 			auto& flags = ws.world.gp_relationship_get_status(sr);
@@ -2617,6 +2619,7 @@ uint32_t ef_release_vassal_this_province(EFFECT_PARAMTERS) {
 		if(ws.world.nation_get_owned_province_count(holder) == 0)
 			return 0;
 		ws.world.force_create_overlord(holder, trigger::to_nation(primary_slot));
+		province::invalidate_land_access(ws, trigger::to_nation(primary_slot));
 		if(ws.world.nation_get_is_great_power(trigger::to_nation(primary_slot))) {
 			auto sr = ws.world.force_create_gp_relationship(holder, trigger::to_nation(primary_slot));
 			auto& flags = ws.world.gp_relationship_get_status(sr);
@@ -2639,6 +2642,7 @@ uint32_t ef_release_vassal_from_nation(EFFECT_PARAMTERS) {
 		if(ws.world.nation_get_owned_province_count(trigger::to_nation(from_slot)) == 0)
 			return 0;
 		ws.world.force_create_overlord(trigger::to_nation(from_slot), trigger::to_nation(primary_slot));
+		province::invalidate_land_access(ws, trigger::to_nation(primary_slot));
 		if(ws.world.nation_get_is_great_power(trigger::to_nation(primary_slot))) {
 			auto sr = ws.world.force_create_gp_relationship(trigger::to_nation(from_slot), trigger::to_nation(primary_slot));
 			auto& flags = ws.world.gp_relationship_get_status(sr);
@@ -2664,6 +2668,7 @@ uint32_t ef_release_vassal_from_province(EFFECT_PARAMTERS) {
 		if(ws.world.nation_get_owned_province_count(holder) == 0)
 			return 0;
 		ws.world.force_create_overlord(holder, trigger::to_nation(primary_slot));
+		province::invalidate_land_access(ws, trigger::to_nation(primary_slot));
 		if(ws.world.nation_get_is_great_power(trigger::to_nation(primary_slot))) {
 			auto sr = ws.world.force_create_gp_relationship(holder, trigger::to_nation(primary_slot));
 			auto& flags = ws.world.gp_relationship_get_status(sr);
@@ -2689,6 +2694,7 @@ uint32_t ef_release_vassal_reb(EFFECT_PARAMTERS) {
 		if(ws.world.nation_get_owned_province_count(holder) == 0)
 			return 0;
 		ws.world.force_create_overlord(holder, trigger::to_nation(primary_slot));
+		province::invalidate_land_access(ws, trigger::to_nation(primary_slot));
 		if(ws.world.nation_get_is_great_power(trigger::to_nation(primary_slot))) {
 			auto sr = ws.world.force_create_gp_relationship(holder, trigger::to_nation(primary_slot));
 			auto& flags = ws.world.gp_relationship_get_status(sr);
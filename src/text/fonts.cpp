@@ -1149,41 +1149,42 @@ void font_manager::load_font(font& fnt, char const* file_data, uint32_t file_siz
 			fnt.glyph_advances[i] = static_cast<float>(fnt.font_face->glyph->metrics.horiAdvance) / static_cast<float>((1 << 6) * magnification_factor);
 		}
 	}
+
+	fnt.make_kerning_table();
 }
 
 float font::kerning(char codepoint_first, char codepoint_second)  {
-	if(auto it = kernings.find(uint16_t((uint16_t(codepoint_first) << 8) | uint16_t(codepoint_second))); it != kernings.end()) {
-		return it->second;
-	}
-
-	auto utf16_first = win1250toUTF16(codepoint_first);
-	auto utf16_second = win1250toUTF16(codepoint_second);
-	auto index_a = FT_Get_Char_Index(font_face, utf16_first);
-	auto index_b = FT_Get_Char_Index(font_face, utf16_second);
-
-	if(index_a && gs && features == font_feature::small_caps) {
-		index_a = gsub::perform_glyph_subs(gs, substitution_indices, index_a);
-	}
-	if(index_b && gs && features == font_feature::small_caps) {
-		index_b = gsub::perform_glyph_subs(gs, substitution_indices, index_b);
-	}
-
-	if((index_a == 0) || (index_b == 0)) {
-		kernings.insert_or_assign(uint16_t((uint16_t(codepoint_first) << 8) | uint16_t(codepoint_second)), 0.0f);
+	if(kernings.empty())
 		return 0.0f;
+	return kernings[(size_t(uint8_t(codepoint_first)) << 8) | size_t(uint8_t(codepoint_second))];
+}
+
+void font::make_kerning_table() {
+	uint32_t indices[256] = { 0 };
+	for(int32_t i = 0; i < 256; ++i) {
+		indices[i] = FT_Get_Char_Index(font_face, win1250toUTF16(char(i)));
+		if(indices[i] && gs && features == font_feature::small_caps) {
+			indices[i] = gsub::perform_glyph_subs(gs, substitution_indices, indices[i]);
+		}
 	}
 
-	if(FT_HAS_KERNING(font_face)) {
-		FT_Vector kerning;
-		FT_Get_Kerning(font_face, index_a, index_b, FT_KERNING_DEFAULT, &kerning);
-		auto res = static_cast<float>(kerning.x) / static_cast<float>((1 << 6) * magnification_factor);
-		kernings.insert_or_assign(uint16_t((uint16_t(codepoint_first) << 8) | uint16_t(codepoint_second)), res);
-		return res;
-	} else {
-		auto rval = gpos::net_kerning(type_2_kerning_tables, index_a, index_b);
-		auto res = rval * float(64)  / float(font_face->units_per_EM);
-		kernings.insert_or_assign(uint16_t((uint16_t(codepoint_first) << 8) | uint16_t(codepoint_second)), res);
-		return res;
+	kernings.assign(256 * 256, 0.0f);
+	bool const has_kerning = FT_HAS_KERNING(font_face);
+	for(int32_t a = 0; a < 256; ++a) {
+		if(indices[a] == 0)
+			continue;
+		for(int32_t b = 0; b < 256; ++b) {
+			if(indices[b] == 0)
+				continue;
+			if(has_kerning) {
+				FT_Vector kerning;
+				FT_Get_Kerning(font_face, indices[a], indices[b], FT_KERNING_DEFAULT, &kerning);
+				kernings[(a << 8) | b] = static_cast<float>(kerning.x) / static_cast<float>((1 << 6) * magnification_factor);
+			} else {
+				auto rval = gpos::net_kerning(type_2_kerning_tables, indices[a], indices[b]);
+				kernings[(a << 8) | b] = rval * float(64) / float(font_face->units_per_EM);
+			}
+		}
 	}
 }
 
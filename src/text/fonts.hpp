@@ -39,7 +39,7 @@ private:
 
 public:
 	FT_Face font_face;
-	ankerl::unordered_dense::map<uint16_t, float> kernings;
+	std::vector<float> kernings; // 256 x 256, by (first << 8) | second, filled in when the font is loaded
 	std::vector<uint16_t> substitution_indices;
 	std::vector<uint8_t const*> type_2_kerning_tables;
 	uint8_t const* gs = nullptr;
@@ -67,6 +67,7 @@ public:
 	float descender(int32_t size) const;
 	float top_adjustment(int32_t size) const;
 	float kerning(char codepoint_first, char codepoint_second);
+	void make_kerning_table();
 	float text_extent(sys::state& state, char const* codepoints, uint32_t count, int32_t size);
 
 	friend class font_manager;
@@ -225,3 +225,215 @@ TEST_CASE("cyto payload tests", "[misc_tests]") {
 		REQUIRE(any_cast<void *>(vp_payload) == (void *)nullptr);
 	}
 }
+
+TEST_CASE("land combat lanes match per-regiment damage", "[misc_tests]") {
+	// the four kinds of shot, written out as update_land_battles used to compute them one regiment at a time
+	float const str_mul = military::str_dam_mul;
+	float const org_mul = military::org_dam_mul;
+	auto lanes = std::make_unique<military::land_combat_lanes>();
+
+	uint32_t seed = 12345;
+	auto next = [&](float lo, float hi) {
+		seed = seed * 1664525u + 1013904223u;
+		return lo + (hi - lo) * float(seed >> 8) / float(1 << 24);
+	};
+
+	for(int32_t round = 0; round < 64; ++round) {
+		float attacker_mod = next(0.5f, 2.0f);
+		float defender_mod = next(0.5f, 2.0f);
+		float defender_fort = 1.0f + 0.1f * float(round % 7);
+		float attacker_org_bonus = next(1.0f, 1.5f);
+		float defender_org_bonus = next(1.0f, 1.5f);
+
+		float expected_str[military::land_combat_lanes::max_lanes];
+		float expected_org[military::land_combat_lanes::max_lanes];
+
+		lanes->count = 0;
+		while(lanes->count + 4 <= military::land_combat_lanes::max_lanes) {
+			float from_power = next(0.0f, 40.0f);
+			float from_support = next(0.0f, 2.0f);
+			float from_discipline = next(0.5f, 1.5f);
+			float to_discipline = next(0.5f, 1.5f);
+			float tactics = next(0.5f, 1.5f);
+			float org_defense = 1.0f + next(0.0f, 0.5f);
+			float power = from_power * 0.1f + 1.0f;
+
+			for(int32_t kind = 0; kind < 4; ++kind) {
+				auto k = lanes->count++;
+				bool to_attacker = (kind & 1) != 0;
+				bool from_back_line = kind < 2;
+				lanes->power[k] = power;
+				lanes->support[k] = from_back_line ? from_support : 1.0f;
+				lanes->side_mod[k] = to_attacker ? defender_mod : attacker_mod;
+				lanes->fort[k] = to_attacker ? 1.0f : defender_fort;
+				lanes->tactics[k] = tactics;
+				lanes->org_defense[k] = org_defense;
+				switch(kind) {
+					case 0: // attacker back line -> defender front line
+						lanes->org_first[k] = defender_org_bonus;
+						lanes->org_second[k] = to_discipline;
+						expected_str[k] = str_mul * power * from_support * attacker_mod / (defender_fort * tactics);
+						expected_org[k] = org_mul * power * from_support * attacker_mod / (defender_fort * defender_org_bonus * to_discipline * org_defense);
+						break;
+					case 1: // defender back line -> attacker front line
+						lanes->org_first[k] = attacker_org_bonus;
+						lanes->org_second[k] = from_discipline;
+						expected_str[k] = str_mul * power * from_support * defender_mod / (tactics);
+						expected_org[k] = org_mul * power * from_support * defender_mod / (attacker_org_bonus * from_discipline * org_defense);
+						break;
+					case 2: // attacker front line -> defender front line
+						lanes->org_first[k] = to_discipline;
+						lanes->org_second[k] = defender_org_bonus;
+						expected_str[k] = str_mul * power * attacker_mod / (defender_fort * tactics);
+						expected_org[k] = org_mul * power * attacker_mod / (defender_fort * to_discipline * defender_org_bonus * org_defense);
+						break;
+					case 3: // defender front line -> attacker front line
+						lanes->org_first[k] = attacker_org_bonus;
+						lanes->org_second[k] = from_discipline;
+						expected_str[k] = str_mul * power * defender_mod / (tactics);
+						expected_org[k] = org_mul * power * defender_mod / (attacker_org_bonus * from_discipline * org_defense);
+						break;
+				}
+			}
+		}
+
+		military::compute_land_combat_damage(*lanes);
+
+		for(int32_t k = 0; k < lanes->count; ++k) {
+			REQUIRE(lanes->str_damage[k] == expected_str[k]);
+			REQUIRE(lanes->org_damage[k] == expected_org[k]);
+		}
+	}
+}
+
+TEST_CASE("border edge visit map", "[misc_tests]") {
+	map::edge_visit_map visited(100, 10);
+
+	REQUIRE(!visited.test(0, 0));
+	visited.set(0, 0);
+	REQUIRE(visited.test(0, 0));
+	// the edges just across the date line are the same edges
+	REQUIRE(visited.test(100, 0));
+	REQUIRE(!visited.test(-1, 1));
+	visited.set(-1, 1);
+	REQUIRE(visited.test(99, 1));
+	REQUIRE(!visited.test(99, 0));
+	REQUIRE(!visited.test(0, 2));
+	// nothing lies beyond the top and bottom of the map
+	REQUIRE(visited.test(5, -1));
+	REQUIRE(visited.test(5, 20));
+	REQUIRE(!visited.test(5, 19));
+}
+
+TEST_CASE("ui quad batching", "[misc_tests]") {
+	float const square[] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 0.0f, 1.0f, 0.0f };
+
+	ogl::quad_batch batch;
+	ogl::quad_batch_key a;
+	a.texture = 1;
+	ogl::quad_batch_key b = a;
+	b.texture = 2;
+
+	batch.add_quad(a, square, 10.0f, 20.0f, 4.0f, 8.0f);
+	batch.add_quad(a, square, 0.0f, 0.0f, 1.0f, 1.0f);
+	batch.add_quad(b, square, 0.0f, 0.0f, 1.0f, 1.0f);
+	// the same key again after another one must not be merged back, or it would draw under the quad in between
+	batch.add_quad(a, square, 0.0f, 0.0f, 1.0f, 1.0f, 0.25f, 0.5f, 0.0f, 0.125f);
+
+	REQUIRE(batch.runs.size() == 3);
+	REQUIRE(batch.runs[0].first_vertex == 0);
+	REQUIRE(batch.runs[0].vertex_count == 12);
+	REQUIRE(batch.runs[1].key == b);
+	REQUIRE(batch.runs[1].first_vertex == 12);
+	REQUIRE(batch.runs[2].first_vertex == 18);
+	REQUIRE(batch.vertices.size() == 24);
+
+	// two triangles out of the fan 0 1 2 3
+	REQUIRE(batch.vertices[0].x == 10.0f);
+	REQUIRE(batch.vertices[0].y == 20.0f);
+	REQUIRE(batch.vertices[2].x == 14.0f);
+	REQUIRE(batch.vertices[2].y == 28.0f);
+	REQUIRE(batch.vertices[5].x == 14.0f);
+	REQUIRE(batch.vertices[5].y == 20.0f);
+
+	// sub rectangle of the texture
+	REQUIRE(batch.vertices[18].u == 0.25f);
+	REQUIRE(batch.vertices[20].u == 0.75f);
+	REQUIRE(batch.vertices[20].v == 0.125f);
+
+	batch.clear();
+	REQUIRE(batch.empty());
+	REQUIRE(batch.vertices.empty());
+}
+
+TEST_CASE("incremental list sorting", "[misc_tests]") {
+	ui::sorted_row_index<dcon::pop_id> index;
+	std::vector<float> key(64);
+	for(size_t i = 0; i < key.size(); i++)
+		key[i] = float((i * 37) % 64);
+	auto key_of = [&](dcon::pop_id p) { return key[p.index()]; };
+
+	std::vector<dcon::pop_id> rows;
+	std::vector<dcon::pop_id> collected;
+	for(int32_t i = 0; i < 48; i++)
+		collected.push_back(dcon::pop_id(dcon::pop_id::value_base_t(i)));
+	index.update_rows(rows, collected);
+	REQUIRE(rows.size() == 48);
+	index.sort(rows, key_of, false);
+	for(size_t i = 1; i < rows.size(); i++)
+		REQUIRE(key_of(rows[i - 1]) <= key_of(rows[i]));
+
+	// some rows go away, some new ones come in and a few keys change
+	collected.clear();
+	for(int32_t i = 8; i < 64; i++)
+		collected.push_back(dcon::pop_id(dcon::pop_id::value_base_t(i)));
+	key[10] = 100.0f;
+	key[20] = -1.0f;
+	key[30] = 17.5f;
+	index.update_rows(rows, collected);
+	REQUIRE(rows.size() == 56);
+	index.sort(rows, key_of, true);
+	REQUIRE(rows.size() == 56);
+	REQUIRE(rows.front() == dcon::pop_id(dcon::pop_id::value_base_t(10)));
+	REQUIRE(rows.back() == dcon::pop_id(dcon::pop_id::value_base_t(20)));
+	for(size_t i = 1; i < rows.size(); i++)
+		REQUIRE(key_of(rows[i - 1]) >= key_of(rows[i]));
+	for(auto r : rows)
+		REQUIRE(r.index() >= 8);
+}
+
+TEST_CASE("tooltip trigger descriptions outlive a snapshot", "[misc_tests]") {
+	std::unique_ptr<sys::state> state = std::make_unique<sys::state>(); // too big for the stack
+
+	int32_t made = 0;
+	auto rebuild_tooltip = [&]() {
+		state->ui_frame_snapshot = nullptr; // as at the start of a frame
+		auto contents = text::create_columnar_layout(state->ui_state.tooltip->internal_layout,
+				text::layout_parameters{ 0, 0, 400, 1000, 0, 0, text::alignment::left, text::text_color::white, true }, 400);
+		ui::write_cached_description(*state, contents, ui::cached_description_key{ 7, 1, 2, 3 }, ui::trigger_description_epoch(*state),
+				[&]() {
+			++made;
+			contents.base_layout.contents.push_back(text::text_chunk{});
+			++contents.base_layout.number_of_lines;
+		});
+		return contents.base_layout.contents.size();
+	};
+
+	state->publish_ui_snapshot();
+	REQUIRE(rebuild_tooltip() == 1);
+	REQUIRE(made == 1);
+
+	// a tick goes by: a new snapshot, but no owner or name has changed
+	state->publish_ui_snapshot();
+	REQUIRE(rebuild_tooltip() == 1);
+	REQUIRE(made == 1);
+
+	++state->ownership_epoch;
+	state->publish_ui_snapshot();
+	REQUIRE(rebuild_tooltip() == 1);
+	REQUIRE(made == 2);
+
+	ui::clear_description_cache(*state);
+	REQUIRE(rebuild_tooltip() == 1);
+	REQUIRE(made == 3);
+}
@@ -0,0 +1,154 @@
+#include <cstring>
+#include <cstdlib>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include "catch.hpp"
+#include "dcon_generated.hpp"
+#include "system_state.hpp"
+#include "serialization.hpp"
+#include "network.hpp"
+#include "commands.hpp"
+
+#ifndef IGNORE_REAL_FILES_TESTS
+
+/* Soak test of the multiplayer code: a host and a few clients are run in this same process, talking over
+   localhost sockets, while the clients keep sending commands. The number of clients and days simulated can be
+   changed with the ALICE_SOAK_CLIENTS and ALICE_SOAK_DAYS environment variables */
+
+static int32_t soak_setting(char const* name, int32_t default_value) {
+	auto str = std::getenv(name);
+	if(str == nullptr)
+		return default_value;
+	auto v = std::atoi(str);
+	return v > 0 ? v : default_value;
+}
+
+static void soak_pump(sys::state& host, std::vector<std::unique_ptr<sys::state>>& clients) {
+	network::send_and_receive_commands(host);
+	for(auto& c : clients)
+		network::send_and_receive_commands(*c);
+}
+
+template<typename F>
+static bool soak_pump_until(sys::state& host, std::vector<std::unique_ptr<sys::state>>& clients, F&& condition) {
+	auto start = std::chrono::steady_clock::now();
+	while(!condition()) {
+		soak_pump(host, clients);
+		if(std::chrono::steady_clock::now() - start > std::chrono::seconds(30))
+			return false;
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	return true;
+}
+
+// Stops the network sessions of the host and clients when the test ends, also when an assertion fails part way through,
+// as destroying a state whose network threads are still running would terminate the whole test run
+struct soak_sessions {
+	sys::state& host;
+	std::vector<std::unique_ptr<sys::state>>& clients;
+
+	~soak_sessions() {
+		for(auto& c : clients)
+			network::finish(*c);
+		network::finish(host);
+	}
+};
+
+static double soak_percentile(std::vector<double>& values, double p) {
+	if(values.empty())
+		return 0.0;
+	std::sort(values.begin(), values.end());
+	auto index = std::min(values.size() - 1, size_t(p * double(values.size() - 1) + 0.5));
+	return values[index];
+}
+
+TEST_CASE("mp_loopback_soak", "[network][req-game-files]") {
+	int32_t const client_count = soak_setting("ALICE_SOAK_CLIENTS", 2);
+	int32_t const day_count = soak_setting("ALICE_SOAK_DAYS", 31);
+
+	std::unique_ptr<sys::state> host = load_testing_scenario_file();
+	host->network_mode = sys::network_mode_type::host;
+	network::init(*host);
+	std::vector<std::unique_ptr<sys::state>> clients;
+	soak_sessions sessions{ *host, clients };
+	REQUIRE(bool(host->local_player_nation));
+
+	// clients join one at a time, so that each of them gets its own nation
+	for(int32_t i = 0; i < client_count; i++) {
+		auto client = load_testing_scenario_file();
+		client->network_mode = sys::network_mode_type::client;
+		client->network_state.ip_address = "127.0.0.1";
+		network::init(*client);
+		clients.push_back(std::move(client));
+
+		auto& joined = *clients.back();
+		REQUIRE(soak_pump_until(*host, clients, [&]() {
+			return !joined.network_state.handshake && joined.world.nation_get_is_player_controlled(joined.local_player_nation)
+				&& host->world.nation_get_is_player_controlled(joined.local_player_nation);
+		}));
+	}
+
+	command::notify_start_game(*host, host->local_player_nation);
+	REQUIRE(soak_pump_until(*host, clients, [&]() {
+		if(host->mode != sys::game_mode_type::in_game)
+			return false;
+		for(auto& c : clients)
+			if(c->mode != sys::game_mode_type::in_game)
+				return false;
+		return true;
+	}));
+
+	std::vector<double> latencies_ms;
+	auto start_date = host->current_date;
+	auto start_time = std::chrono::steady_clock::now();
+	for(int32_t day = 0; day < day_count; day++) {
+		// every client changes its taxes once a week, and we time how long it takes to see it come back
+		if(day % 7 == 0) {
+			for(size_t i = 0; i < clients.size(); i++) {
+				auto& c = *clients[i];
+				command::budget_settings_data values;
+				std::memset(&values, int8_t(-127), sizeof(values));
+				values.poor_tax = int8_t((day * 13 + int32_t(i) * 29) % 100);
+				command::change_budget_settings(c, c.local_player_nation, values);
+
+				auto issued = std::chrono::steady_clock::now();
+				REQUIRE(soak_pump_until(*host, clients, [&]() {
+					return c.world.nation_get_poor_tax(c.local_player_nation) == values.poor_tax;
+				}));
+				latencies_ms.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - issued).count());
+			}
+		}
+		host->single_game_tick();
+		soak_pump(*host, clients);
+	}
+	// wait for the last lockstep frame to reach everyone
+	REQUIRE(soak_pump_until(*host, clients, [&]() {
+		for(auto& c : clients)
+			if(c->current_date != host->current_date)
+				return false;
+		return true;
+	}));
+	auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+	int32_t oos_count = 0;
+	auto host_checksum = host->get_save_checksum();
+	for(auto& c : clients) {
+		if(c->network_state.out_of_sync || !host_checksum.is_equal(c->get_save_checksum()))
+			++oos_count;
+	}
+	size_t total_sent = 0;
+	for(auto const& c : host->network_state.clients)
+		total_sent += c.total_sent_bytes.load(std::memory_order::acquire);
+	auto days = std::max(1, host->current_date.to_raw_value() - start_date.to_raw_value());
+
+	WARN("clients: " << client_count << ", days: " << days
+		<< "\nout of sync clients: " << oos_count
+		<< "\nbytes sent per day: " << double(total_sent) / double(days)
+		<< "\ncommand latency (ms) p50: " << soak_percentile(latencies_ms, 0.5) << " p90: " << soak_percentile(latencies_ms, 0.9) << " p99: " << soak_percentile(latencies_ms, 0.99)
+		<< "\nticks per second: " << double(days) / elapsed);
+
+	REQUIRE(oos_count == 0);
+}
+
+#endif